@@ -48,6 +48,26 @@ function(cpp_test NAME)
 
 endfunction() # cpp_test
 
+# Build C++ benchmark executable program, if BUILD_BENCHMARKING is enabled.
+# A ${NAME}_run target is also added, which runs the benchmark and writes its
+# results to ${NAME}.json in the current binary directory.
+function(cpp_benchmark NAME)
+    if (NOT BUILD_BENCHMARKING)
+        return()
+    endif()
+
+    _cpp_executable(${NAME}
+        ${ARGN}
+    )
+    add_custom_target(${NAME}_run
+        COMMAND $<TARGET_FILE:${NAME}>
+            --json ${CMAKE_CURRENT_BINARY_DIR}/${NAME}.json
+        DEPENDS ${NAME}
+        USES_TERMINAL
+    )
+
+endfunction() # cpp_benchmark
+
 # Builds a new C++ library.
 function(
     cpp_library
@@ -0,0 +1,421 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/// \class AllocationResult
+///
+/// The storage returned by an \p allocate_at_least call: a pointer, and the
+/// number of elements actually available, which may exceed the request.
+///
+/// \tparam PointerT The pointer type.
+template<typename PointerT>
+struct AllocationResult
+{
+    PointerT ptr = nullptr;
+    std::size_t count = 0;
+};
+
+/// \concept AtLeastAllocator
+///
+/// An allocator which can report the real capacity of an allocation via
+/// \p allocate_at_least(count), mirroring the C++23 allocator interface.
+template<typename AllocatorT>
+concept AtLeastAllocator = requires(AllocatorT& allocator, std::size_t count)
+{
+    {
+        allocator.allocate_at_least(count)
+    } -> std::same_as<AllocationResult<typename AllocatorT::value_type*>>;
+};
+
+/// \concept InlineStorageAllocator
+///
+/// An allocator which embeds up to \p inline_capacity elements of storage
+/// within itself.
+///
+/// Such storage cannot be handed over to another container, so containers
+/// must query \p is_inline(ptr) before adopting a buffer, and move elements
+/// individually when it returns true.
+template<typename AllocatorT>
+concept InlineStorageAllocator =
+    requires(const AllocatorT& allocator,
+             const typename AllocatorT::value_type* ptr)
+{
+    {
+        AllocatorT::inline_capacity
+    } -> std::convertible_to<std::size_t>;
+    {
+        allocator.is_inline(ptr)
+    } -> std::same_as<bool>;
+};
+
+/// \concept ReallocatableAllocator
+///
+/// An allocator which, in addition to the standard Allocator requirements,
+/// can resize an existing allocation via
+/// \p reallocate(ptr, oldCount, newCount).
+///
+/// Re-allocation is free to move the block bytewise, so containers must only
+/// use it for trivially relocatable element types.
+template<typename AllocatorT>
+concept ReallocatableAllocator = requires(AllocatorT& allocator,
+                                          typename AllocatorT::value_type* ptr,
+                                          std::size_t count)
+{
+    {
+        allocator.reallocate(ptr, count, count)
+    } -> std::same_as<typename AllocatorT::value_type*>;
+};
+
+/// \concept AlignedAllocator
+///
+/// An allocator which guarantees that every allocation starts on a multiple
+/// of its static \p alignment, in bytes.
+template<typename AllocatorT>
+concept AlignedAllocator = requires
+{
+    {
+        AllocatorT::alignment
+    } -> std::convertible_to<std::size_t>;
+};
+
+/// \var AllocatorAlignment
+///
+/// The alignment, in bytes, of allocations made by \p AllocatorT: its
+/// \p alignment if it is an \ref AlignedAllocator, else the alignment of its
+/// value type.
+template<typename AllocatorT>
+inline constexpr std::size_t AllocatorAlignment =
+    alignof(typename AllocatorT::value_type);
+
+template<AlignedAllocator AllocatorT>
+inline constexpr std::size_t AllocatorAlignment<AllocatorT> =
+    AllocatorT::alignment;
+
+/// \var DefaultAlignment
+///
+/// The default alignment of \ref MallocAllocator storage: a full cache line
+/// for arithmetic types, so that SIMD kernels can use aligned loads and never
+/// straddle cache lines at the start of a buffer, else the natural alignment
+/// of \p ValueT.
+template<typename ValueT>
+inline constexpr std::size_t DefaultAlignment =
+    std::is_arithmetic_v<ValueT> ? std::max<std::size_t>(64, alignof(ValueT))
+                                 : alignof(ValueT);
+
+/// \class MallocAllocator
+///
+/// Stateless allocator backed by the C heap (\p malloc, \p realloc and
+/// \p free).
+///
+/// This is the default allocator of \ref Vector, as \p realloc can grow a
+/// block in place (or, for large blocks, re-map its pages) instead of copying.
+///
+/// Alignments beyond that of \p malloc are served by \p aligned_alloc.
+/// Such blocks are still resized with \p realloc, which preserves the offset
+/// of large blocks within their pages, and only fall back to a copy into a
+/// fresh aligned block when the result is mis-aligned.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam AlignmentV The alignment of each allocation, in bytes.
+template<typename ValueT, std::size_t AlignmentV = DefaultAlignment<ValueT>>
+class MallocAllocator
+{
+    static_assert((AlignmentV & (AlignmentV - 1)) == 0,
+                  "Alignment must be a power of two.");
+    static_assert(AlignmentV >= alignof(ValueT),
+                  "Alignment must satisfy the value type.");
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// The alignment of each allocation, in bytes.
+    static constexpr std::size_t alignment = AlignmentV;
+
+    template<typename OtherT>
+    struct rebind
+    {
+        using other =
+            MallocAllocator<OtherT, std::max(AlignmentV, alignof(OtherT))>;
+    };
+
+    /// \typedef is_always_equal
+    ///
+    /// Any instance can free memory allocated by another.
+    using is_always_equal = std::true_type;
+
+    /// \typedef propagate_on_container_move_assignment
+    ///
+    /// Containers may adopt each others' storage on move assignment.
+    using propagate_on_container_move_assignment = std::true_type;
+
+    /// Default constructor.
+    MallocAllocator() = default;
+
+    /// Converting constructor, from an allocator of another value type.
+    template<typename OtherT, std::size_t OtherAlignmentV>
+    MallocAllocator(const MallocAllocator<OtherT, OtherAlignmentV>&) noexcept
+    {}
+
+    /// Allocate storage for \p count elements.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return Pointer to the un-initialized storage.
+    value_type* allocate(std::size_t count)
+    {
+        void* ptr = _Allocate(sizeof(value_type) * count);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<value_type*>(ptr);
+    }
+
+    /// Resize the storage at \p ptr to hold \p newCount elements, preserving
+    /// the bytes of the first \p oldCount elements.
+    ///
+    /// \param ptr The existing allocation, or \p nullptr.
+    /// \param oldCount The number of elements in the existing allocation.
+    /// \param newCount The number of elements to resize to.
+    ///
+    /// \return Pointer to the resized storage, which may differ from \p ptr.
+    ///
+    /// \throws std::bad_alloc If the storage cannot be resized, leaving
+    /// \p ptr intact.  Over-aligned storage which \p realloc moves to a
+    /// mis-aligned address is copied into a new aligned block, and the
+    /// process aborts if that block cannot be allocated.
+    value_type* reallocate(value_type* ptr,
+                           std::size_t oldCount,
+                           std::size_t newCount)
+    {
+        if constexpr (_IsOverAligned()) {
+            return _AlignedReallocate(ptr, oldCount, newCount);
+        }
+
+        void* newPtr =
+            realloc(static_cast<void*>(ptr), sizeof(value_type) * newCount);
+        if (newPtr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<value_type*>(newPtr);
+    }
+
+    /// Free storage previously returned by \ref allocate or \ref reallocate.
+    ///
+    /// \param ptr The allocation.
+    /// \param count The number of elements in the allocation.
+    void deallocate(value_type* ptr, std::size_t /* count */) noexcept
+    {
+        free(ptr);
+    }
+
+    template<typename OtherT, std::size_t OtherAlignmentV>
+    bool operator==(
+        const MallocAllocator<OtherT, OtherAlignmentV>&) const noexcept
+    {
+        return true;
+    }
+
+private:
+    // Check if the alignment exceeds that guaranteed by malloc.
+    static constexpr bool _IsOverAligned()
+    {
+        return AlignmentV > alignof(std::max_align_t);
+    }
+
+    // Allocate \p bytes of storage, honoring the alignment.
+    static void* _Allocate(std::size_t bytes)
+    {
+        if constexpr (_IsOverAligned()) {
+            // aligned_alloc requires a size which is a multiple of the
+            // alignment.
+            return aligned_alloc(AlignmentV,
+                                 (bytes + AlignmentV - 1) / AlignmentV *
+                                     AlignmentV);
+        } else {
+            return malloc(bytes);
+        }
+    }
+
+    // realloc only honors the alignment of malloc, so should it move the
+    // block to a mis-aligned address, the contents are copied into a fresh
+    // aligned block.  Growing in place, or re-mapping a large block, keeps
+    // the alignment, so the common case costs a single realloc.
+    static value_type* _AlignedReallocate(value_type* ptr,
+                                          std::size_t oldCount,
+                                          std::size_t newCount)
+    {
+        std::size_t bytes = sizeof(value_type) * newCount;
+        void* newPtr = ptr == nullptr
+                           ? _Allocate(bytes)
+                           : realloc(static_cast<void*>(ptr), bytes);
+        if (newPtr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        if (reinterpret_cast<std::uintptr_t>(newPtr) % AlignmentV == 0) {
+            return static_cast<value_type*>(newPtr);
+        }
+
+        // \p ptr is already released, and the contents only live in the
+        // mis-aligned block, so running out of memory here is unrecoverable.
+        void* alignedPtr = _Allocate(bytes);
+        if (alignedPtr == nullptr) {
+            std::abort();
+        }
+
+        memcpy(alignedPtr,
+               newPtr,
+               sizeof(value_type) * std::min(oldCount, newCount));
+        free(newPtr);
+        return static_cast<value_type*>(alignedPtr);
+    }
+};
+
+/// \class InlineAllocator
+///
+/// Allocator which embeds storage for \p InlineCapacityV elements, handing it
+/// out for the first allocation which fits, and forwarding any other
+/// allocation to \p FallbackAllocatorT.
+///
+/// Copies of an InlineAllocator get their own, unused inline storage.  This
+/// makes it suitable only for containers which are aware of
+/// \ref InlineStorageAllocator, such as \ref Vector (see \ref SmallVector).
+///
+/// \tparam ValueT The type of each element.
+/// \tparam InlineCapacityV The number of elements stored inline.
+/// \tparam FallbackAllocatorT The allocator for requests which do not fit
+/// inline.
+template<typename ValueT,
+         std::size_t InlineCapacityV,
+         typename FallbackAllocatorT = MallocAllocator<ValueT>>
+class InlineAllocator
+{
+    static_assert(InlineCapacityV > 0, "Inline capacity must be non-zero.");
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef fallback_allocator_type
+    ///
+    /// The allocator for requests which do not fit inline.
+    using fallback_allocator_type = FallbackAllocatorT;
+
+    /// The number of elements stored inline.
+    static constexpr std::size_t inline_capacity = InlineCapacityV;
+
+    template<typename OtherT>
+    struct rebind
+    {
+        using other = InlineAllocator<
+            OtherT,
+            InlineCapacityV,
+            typename std::allocator_traits<
+                FallbackAllocatorT>::template rebind_alloc<OtherT>>;
+    };
+
+    /// Default constructor.
+    InlineAllocator() = default;
+
+    /// Constructs with a copy of \p fallback.
+    explicit InlineAllocator(const FallbackAllocatorT& fallback)
+      : m_fallback(fallback)
+    {}
+
+    /// Copy constructor.  The inline storage is \em not copied.
+    InlineAllocator(const InlineAllocator& other)
+      : m_fallback(other.m_fallback)
+    {}
+
+    /// Copy assignment.  The inline storage is left untouched.
+    InlineAllocator& operator=(const InlineAllocator& other)
+    {
+        m_fallback = other.m_fallback;
+        return *this;
+    }
+
+    /// Allocate storage for \p count elements.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return Pointer to the un-initialized storage.
+    value_type* allocate(std::size_t count)
+    {
+        return allocate_at_least(count).ptr;
+    }
+
+    /// Allocate storage for at least \p count elements.  Requests served
+    /// inline report the full inline capacity.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return The storage and its real capacity.
+    AllocationResult<value_type*> allocate_at_least(std::size_t count)
+    {
+        if (!m_inlineInUse && count <= InlineCapacityV) {
+            m_inlineInUse = true;
+            return { _InlineBuffer(), InlineCapacityV };
+        }
+
+        return { std::allocator_traits<FallbackAllocatorT>::allocate(
+                     m_fallback, count),
+                 count };
+    }
+
+    /// Free storage previously returned by \ref allocate.
+    ///
+    /// \param ptr The allocation.
+    /// \param count The number of elements in the allocation.
+    void deallocate(value_type* ptr, std::size_t count) noexcept
+    {
+        if (is_inline(ptr)) {
+            m_inlineInUse = false;
+        } else {
+            std::allocator_traits<FallbackAllocatorT>::deallocate(
+                m_fallback, ptr, count);
+        }
+    }
+
+    /// Check if \p ptr points to the inline storage of this allocator.
+    bool is_inline(const value_type* ptr) const
+    {
+        return ptr != nullptr &&
+               ptr == reinterpret_cast<const value_type*>(m_storage);
+    }
+
+    /// Get the allocator for requests which do not fit inline.
+    const FallbackAllocatorT& fallback_allocator() const { return m_fallback; }
+
+    /// Heap allocations are interchangeable when the fallbacks are; inline
+    /// storage never is, see \ref is_inline.
+    bool operator==(const InlineAllocator& other) const noexcept
+    {
+        return m_fallback == other.m_fallback;
+    }
+
+private:
+    value_type* _InlineBuffer()
+    {
+        return reinterpret_cast<value_type*>(m_storage);
+    }
+
+    alignas(value_type) std::byte m_storage[sizeof(value_type) *
+                                            InlineCapacityV];
+    bool m_inlineInUse = false;
+    [[no_unique_address]] FallbackAllocatorT m_fallback;
+};
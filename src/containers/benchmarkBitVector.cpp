@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <vector>
+
+#include "benchmarkSuite.h"
+#include "bitVector.h"
+
+// Compares bitwise operations on 1G bits in a BitVector against
+// std::vector<bool>, and times BitVector's rank and select queries.
+
+static void _BenchmarkBitVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numBits = 1'000'000'000;
+    BitVector lhs(numBits);
+    BitVector rhs(numBits, true);
+    std::vector<bool> lhsRef(numBits);
+    std::vector<bool> rhsRef(numBits, true);
+    for (size_t index = 0; index < numBits; index += 3) {
+        lhs.set(index);
+        lhsRef[index] = true;
+    }
+
+    suite.Run("and/BitVector", [&] {
+        BitVector result = lhs & rhs;
+        DoNotOptimize(result.size());
+    });
+
+    suite.Run("and/std::vector<bool>", [&] {
+        std::vector<bool> result(numBits);
+        for (size_t index = 0; index < numBits; ++index) {
+            result[index] = lhsRef[index] && rhsRef[index];
+        }
+        DoNotOptimize(result.size());
+    });
+
+    suite.Run("count/BitVector", [&] { DoNotOptimize(lhs.count()); });
+
+    suite.Run("count/std::vector<bool>", [&] {
+        DoNotOptimize(std::count(lhsRef.begin(), lhsRef.end(), true));
+    });
+
+    suite.Run("find_next/BitVector", [&] {
+        size_t visited = 0;
+        for (size_t index = lhs.find_first(); index != BitVector::npos;
+             index = lhs.find_next(index)) {
+            visited++;
+        }
+        DoNotOptimize(visited);
+    });
+
+    lhs.build_rank_index();
+
+    suite.Run("rank/BitVector", [&] { DoNotOptimize(lhs.rank(numBits / 2)); });
+
+    suite.Run("select/BitVector",
+              [&] { DoNotOptimize(lhs.select(numBits / 6)); });
+}
+
+static BenchmarkRegistration s_registration("BitVector", _BenchmarkBitVector);
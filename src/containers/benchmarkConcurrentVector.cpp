@@ -0,0 +1,75 @@
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_for.h>
+
+#include <mutex>
+
+#include "benchmarkSuite.h"
+#include "concurrentVector.h"
+#include "vector.h"
+
+// Compares appending 10M elements from parallel tasks to a ConcurrentVector,
+// against tbb::concurrent_vector and a Vector behind a mutex.
+
+// Append each index of \p range to \p VectorT, one element at a time.
+template<typename VectorT>
+static void _ParallelPushBack(const tbb::blocked_range<size_t>& range)
+{
+    VectorT vec;
+    tbb::parallel_for(range, [&](const tbb::blocked_range<size_t>& r) {
+        for (size_t index = r.begin(); index < r.end(); ++index) {
+            vec.push_back(int(index));
+        }
+    });
+    DoNotOptimize(vec.size());
+}
+
+// Append each index of \p range to \p VectorT, one sub-range at a time.
+template<typename VectorT>
+static void _ParallelGrowBy(const tbb::blocked_range<size_t>& range)
+{
+    VectorT vec;
+    tbb::parallel_for(range, [&](const tbb::blocked_range<size_t>& r) {
+        auto it = vec.grow_by(r.size());
+        for (size_t index = r.begin(); index < r.end(); ++index, ++it) {
+            *it = int(index);
+        }
+    });
+    DoNotOptimize(vec.size());
+}
+
+static void _BenchmarkConcurrentVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 10'000'000;
+    tbb::blocked_range<size_t> range(0, numElements);
+
+    suite.Run("parallel push_back/ConcurrentVector<int>", [&] {
+        _ParallelPushBack<ConcurrentVector<int>>(range);
+    });
+
+    suite.Run("parallel push_back/tbb::concurrent_vector<int>", [&] {
+        _ParallelPushBack<tbb::concurrent_vector<int>>(range);
+    });
+
+    suite.Run("parallel push_back/std::mutex + Vector<int>", [&] {
+        std::mutex mutex;
+        Vector<int> vec;
+        tbb::parallel_for(range, [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t index = r.begin(); index < r.end(); ++index) {
+                std::lock_guard<std::mutex> lock(mutex);
+                vec.push_back(int(index));
+            }
+        });
+        DoNotOptimize(vec.size());
+    });
+
+    suite.Run("parallel grow_by/ConcurrentVector<int>", [&] {
+        _ParallelGrowBy<ConcurrentVector<int>>(range);
+    });
+
+    suite.Run("parallel grow_by/tbb::concurrent_vector<int>", [&] {
+        _ParallelGrowBy<tbb::concurrent_vector<int>>(range);
+    });
+}
+
+static BenchmarkRegistration s_registration("ConcurrentVector",
+                                            _BenchmarkConcurrentVector);
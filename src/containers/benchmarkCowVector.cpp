@@ -0,0 +1,31 @@
+#include "benchmarkSuite.h"
+#include "cowVector.h"
+#include "vector.h"
+
+// Compares a deep copy of a 10M element Vector, against a CowVector snapshot
+// with and without a following write.
+
+static void _BenchmarkCowVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 10'000'000;
+    Vector<int> source(numElements, 1);
+    CowVector<int> cowSource(numElements, 1);
+
+    suite.Run("snapshot/Vector deep copy", [&] {
+        Vector<int> copy(source);
+        DoNotOptimize(copy.data());
+    });
+
+    suite.Run("snapshot/CowVector", [&] {
+        CowVector<int> snapshot(cowSource);
+        DoNotOptimize(snapshot.size());
+    });
+
+    suite.Run("snapshot/CowVector + first write", [&] {
+        CowVector<int> snapshot(cowSource);
+        snapshot.mutable_at(0) = 2;
+        DoNotOptimize(snapshot.size());
+    });
+}
+
+static BenchmarkRegistration s_registration("CowVector", _BenchmarkCowVector);
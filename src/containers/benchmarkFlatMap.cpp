@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include "benchmarkSuite.h"
+#include "flatMap.h"
+#include "vector.h"
+
+// Compares looking up 1M random keys in each FlatMap layout, against
+// std::map and std::unordered_map.
+
+// Make \p count pairs of distinct random keys, mapped to their order of
+// generation.
+static Vector<std::pair<int, int>> _MakeRandomPairs(size_t count,
+                                                    unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::map<int, int> unique;
+    while (unique.size() < count) {
+        unique.emplace(int(engine() >> 1), int(unique.size()));
+    }
+
+    Vector<std::pair<int, int>> pairs(unique.begin(), unique.end());
+    std::shuffle(pairs.begin(), pairs.end(), engine);
+    return pairs;
+}
+
+// Sum the values of \p lookups in \p map, given how to find each of them.
+template<typename MapT, typename FindFnT>
+static void _SumLookups(const MapT& map,
+                        const Vector<int>& lookups,
+                        FindFnT find)
+{
+    long sum = 0;
+    for (int key : lookups) {
+        sum += find(map, key);
+    }
+    DoNotOptimize(sum);
+}
+
+static void _BenchmarkFlatMap(BenchmarkSuite& suite)
+{
+    constexpr size_t numKeys = 1'000'000;
+    constexpr size_t numLookups = 1'000'000;
+    Vector<std::pair<int, int>> pairs = _MakeRandomPairs(numKeys, 1);
+
+    // Look up present keys in a random order.
+    Vector<int> lookups;
+    std::mt19937 engine(2);
+    for (size_t index = 0; index < numLookups; ++index) {
+        lookups.push_back(pairs[engine() % numKeys].first);
+    }
+
+    std::map<int, int> treeMap(pairs.begin(), pairs.end());
+    std::unordered_map<int, int> hashMap(pairs.begin(), pairs.end());
+    FlatMap<int, int> sortedMap(pairs.begin(), pairs.end());
+    FlatMap<int, int, FlatMapLayout::Eytzinger> eytzingerMap(pairs.begin(),
+                                                             pairs.end());
+
+    auto findStd = [](const auto& map, int key) {
+        return map.find(key)->second;
+    };
+    auto findFlat = [](const auto& map, int key) { return *map.find(key); };
+
+    suite.Run("find/std::map",
+              [&] { _SumLookups(treeMap, lookups, findStd); });
+
+    suite.Run("find/std::unordered_map",
+              [&] { _SumLookups(hashMap, lookups, findStd); });
+
+    suite.Run("find/FlatMap<Sorted>",
+              [&] { _SumLookups(sortedMap, lookups, findFlat); });
+
+    suite.Run("find/FlatMap<Eytzinger>",
+              [&] { _SumLookups(eytzingerMap, lookups, findFlat); });
+
+    suite.Run("build/FlatMap<Eytzinger>", [&] {
+        FlatMap<int, int, FlatMapLayout::Eytzinger> map(pairs.begin(),
+                                                        pairs.end());
+        DoNotOptimize(map.size());
+    });
+}
+
+static BenchmarkRegistration s_registration("FlatMap", _BenchmarkFlatMap);
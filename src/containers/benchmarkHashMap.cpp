@@ -0,0 +1,86 @@
+#include <tbb/concurrent_hash_map.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "benchmarkSuite.h"
+#include "hashMap.h"
+#include "vector.h"
+
+// Compares inserting and finding 10M string keys in a HashMap, against
+// std::unordered_map and tbb::concurrent_hash_map.  This is the string-key
+// workload of src/tbb/concurrentHashMap.cpp.
+
+using StringHashMap = HashMap<std::string, std::string>;
+using StdStringMap = std::unordered_map<std::string, std::string>;
+using TbbStringMap = tbb::concurrent_hash_map<std::string, std::string>;
+
+// Insert each of \p keys into \p map, mapped to ten times its index.
+template<typename MapT>
+static void _InsertKeys(MapT& map, const Vector<std::string>& keys)
+{
+    for (size_t index = 0; index < keys.size(); ++index) {
+        map.insert({ keys[index], std::to_string(index * 10) });
+    }
+}
+
+static void _BenchmarkHashMap(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 10'000'000;
+    Vector<std::string> keys;
+    for (size_t index = 0; index < numElements; ++index) {
+        keys.push_back(std::to_string(index));
+    }
+
+    suite.Run("insert/HashMap<std::string>", [&] {
+        StringHashMap map;
+        _InsertKeys(map, keys);
+        DoNotOptimize(map.size());
+    });
+
+    suite.Run("insert/std::unordered_map<std::string>", [&] {
+        StdStringMap map;
+        _InsertKeys(map, keys);
+        DoNotOptimize(map.size());
+    });
+
+    suite.Run("insert/tbb::concurrent_hash_map<std::string>", [&] {
+        TbbStringMap map;
+        _InsertKeys(map, keys);
+        DoNotOptimize(map.size());
+    });
+
+    StringHashMap map;
+    StdStringMap stdMap;
+    TbbStringMap tbbMap;
+    _InsertKeys(map, keys);
+    _InsertKeys(stdMap, keys);
+    _InsertKeys(tbbMap, keys);
+
+    suite.Run("find/HashMap<std::string>", [&] {
+        size_t found = 0;
+        for (const std::string& key : keys) {
+            found += map.find(key) != map.end();
+        }
+        DoNotOptimize(found);
+    });
+
+    suite.Run("find/std::unordered_map<std::string>", [&] {
+        size_t found = 0;
+        for (const std::string& key : keys) {
+            found += stdMap.find(key) != stdMap.end();
+        }
+        DoNotOptimize(found);
+    });
+
+    suite.Run("find/tbb::concurrent_hash_map<std::string>", [&] {
+        size_t found = 0;
+        TbbStringMap::const_accessor accessor;
+        for (const std::string& key : keys) {
+            found += tbbMap.find(accessor, key);
+        }
+        DoNotOptimize(found);
+    });
+}
+
+static BenchmarkRegistration s_registration("HashMap", _BenchmarkHashMap);
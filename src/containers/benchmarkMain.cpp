@@ -0,0 +1,11 @@
+#include "benchmarkSuite.h"
+
+// Runs the benchmarks registered by each benchmark*.cpp file.  Run with:
+//   containers_benchmark [--trials N] [--filter TEXT] [--json PATH]
+
+int main(int argc, char** argv)
+{
+    BenchmarkSuite suite(argc, argv);
+    RunBenchmarkGroups(suite);
+    return suite.Finish();
+}
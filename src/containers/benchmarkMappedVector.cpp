@@ -0,0 +1,55 @@
+#include <cstdio>
+#include <numeric>
+#include <string>
+
+#include <unistd.h>
+
+#include "benchmarkSuite.h"
+#include "mappedVector.h"
+#include "vector.h"
+
+// Compares opening and reading a 256 MiB file through a MappedVector,
+// against reading it into a Vector.
+
+static void _BenchmarkMappedVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 64 * 1024 * 1024;
+
+    char path[] = "/tmp/benchmarkMappedVectorXXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Failed to create a temporary file.\n");
+        return;
+    }
+    close(fd);
+
+    {
+        MappedVector<int, MapMode::ReadWrite> vec(path);
+        vec.resize(numElements);
+        std::iota(vec.begin(), vec.end(), 0);
+    }
+
+    suite.Run("open/MappedVector", [&] {
+        MappedVector<int> vec(path);
+        DoNotOptimize(vec.size());
+    });
+
+    suite.Run("open and sum/MappedVector", [&] {
+        MappedVector<int> vec(path);
+        vec.advise(MADV_SEQUENTIAL);
+        DoNotOptimize(std::accumulate(vec.begin(), vec.end(), 0l));
+    });
+
+    suite.Run("open and sum/Vector fread", [&] {
+        FILE* stream = fopen(path, "rb");
+        Vector<int> vec(numElements, DefaultInit);
+        size_t numRead = fread(vec.data(), sizeof(int), numElements, stream);
+        fclose(stream);
+        DoNotOptimize(std::accumulate(vec.begin(), vec.begin() + numRead, 0l));
+    });
+
+    remove(path);
+}
+
+static BenchmarkRegistration s_registration("MappedVector",
+                                            _BenchmarkMappedVector);
@@ -0,0 +1,94 @@
+#include <tbb/concurrent_queue.h>
+
+#include <string>
+#include <thread>
+
+#include "benchmarkSuite.h"
+#include "mpmcQueue.h"
+#include "vector.h"
+
+// Compares the throughput of a MpmcQueue under growing numbers of producer
+// and consumer threads, against TBB's bounded and unbounded queues.
+
+// Run \p numThreads producers, each calling \p push \p perThread times, and
+// as many consumers, each calling \p pop as many times.
+template<typename PushFnT, typename PopFnT>
+static void _RunThreads(size_t numThreads,
+                        size_t perThread,
+                        PushFnT push,
+                        PopFnT pop)
+{
+    Vector<std::thread> threads;
+    for (size_t thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back([&] {
+            for (size_t index = 0; index < perThread; ++index) {
+                push(int(index));
+            }
+        });
+        threads.emplace_back([&] {
+            for (size_t index = 0; index < perThread; ++index) {
+                pop();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+static void _BenchmarkMpmcQueue(BenchmarkSuite& suite)
+{
+    // Each thread count moves the same number of elements, from as many
+    // producers to as many consumers.
+    constexpr size_t numElements = 1'000'000;
+
+    for (size_t numThreads : { 1, 2, 4, 8, 16, 32, 64 }) {
+        size_t perThread = numElements / numThreads;
+        std::string suffix = " " + std::to_string(numThreads) + "x" +
+                             std::to_string(numThreads);
+
+        suite.Run("push/pop" + suffix + "/MpmcQueue", [&] {
+            MpmcQueue<int> queue(1024);
+            _RunThreads(
+                numThreads,
+                perThread,
+                [&](int value) { queue.push(value); },
+                [&] {
+                    int value;
+                    queue.pop(value);
+                });
+            DoNotOptimize(queue.size_approx());
+        });
+
+        suite.Run("push/pop" + suffix + "/tbb::concurrent_bounded_queue", [&] {
+            tbb::concurrent_bounded_queue<int> queue;
+            queue.set_capacity(1024);
+            _RunThreads(
+                numThreads,
+                perThread,
+                [&](int value) { queue.push(value); },
+                [&] {
+                    int value;
+                    queue.pop(value);
+                });
+            DoNotOptimize(queue.size());
+        });
+
+        suite.Run("push/pop" + suffix + "/tbb::concurrent_queue try_pop spin",
+                  [&] {
+                      tbb::concurrent_queue<int> queue;
+                      _RunThreads(
+                          numThreads,
+                          perThread,
+                          [&](int value) { queue.push(value); },
+                          [&] {
+                              int value;
+                              while (!queue.try_pop(value)) {
+                              }
+                          });
+                      DoNotOptimize(queue.unsafe_size());
+                  });
+    }
+}
+
+static BenchmarkRegistration s_registration("MpmcQueue", _BenchmarkMpmcQueue);
@@ -0,0 +1,68 @@
+#include <array>
+#include <thread>
+
+#include "benchmarkSuite.h"
+#include "objectPool.h"
+#include "spscRing.h"
+
+// Compares recycling the slices of src/tbb/parallelPipeline.cpp through an
+// ObjectPool, against allocating each with new and delete.  Slices are made
+// by one thread and finished with by another, with 64 in flight.
+
+using Slice = std::array<int, 100>;
+
+// Number of slices in flight.
+static constexpr size_t s_numTokens = 64;
+
+// Make \p numSlices slices with \p acquire, hand each to a consumer thread,
+// which gives it back with \p release.
+template<typename AcquireFnT, typename ReleaseFnT>
+static void _HandOffSlices(size_t numSlices,
+                           AcquireFnT acquire,
+                           ReleaseFnT release)
+{
+    SpscRing<Slice*> ring(s_numTokens);
+    std::thread consumer([&] {
+        Slice* slice;
+        for (size_t index = 0; index < numSlices; ++index) {
+            while (!ring.try_pop(slice)) {
+                std::this_thread::yield();
+            }
+            release(slice);
+        }
+    });
+    for (size_t index = 0; index < numSlices; ++index) {
+        Slice* slice = acquire();
+        while (!ring.try_push(slice)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    DoNotOptimize(ring.size_approx());
+}
+
+static void _BenchmarkObjectPool(BenchmarkSuite& suite)
+{
+    constexpr size_t numSlices = 10'000'000;
+
+    suite.Run("slices/new/delete", [] {
+        _HandOffSlices(
+            numSlices,
+            [] { return new Slice(); },
+            [](Slice* slice) { delete slice; });
+    });
+
+    suite.Run("slices/ObjectPool acquire/release", [] {
+        ObjectPool<Slice> pool(s_numTokens);
+        _HandOffSlices(
+            numSlices,
+            [&] {
+                Slice* slice = pool.acquire();
+                slice->fill(0);
+                return slice;
+            },
+            [&](Slice* slice) { pool.release(slice); });
+    });
+}
+
+static BenchmarkRegistration s_registration("ObjectPool", _BenchmarkObjectPool);
@@ -0,0 +1,36 @@
+#include "benchmarkSuite.h"
+#include "parallelAlgorithms.h"
+#include "vector.h"
+
+// Compares the serial copy and fill of a 1 GiB Vector against their parallel
+// counterparts.
+
+static void _BenchmarkParallelAlgorithms(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 256 * 1024 * 1024;
+    Vector<int> src(numElements, 1);
+
+    suite.Run("copy/Vector copy constructor", [&] {
+        Vector<int> copy(src);
+        DoNotOptimize(copy.data());
+    });
+
+    suite.Run("copy/ParallelCopy", [&] {
+        Vector<int> copy = ParallelCopy(src);
+        DoNotOptimize(copy.data());
+    });
+
+    suite.Run("fill/Vector fill constructor", [] {
+        Vector<int> vec(numElements, 2);
+        DoNotOptimize(vec.data());
+    });
+
+    suite.Run("fill/ParallelAssign", [] {
+        Vector<int> vec;
+        ParallelAssign(vec, numElements, 2);
+        DoNotOptimize(vec.data());
+    });
+}
+
+static BenchmarkRegistration s_registration("ParallelAlgorithms",
+                                            _BenchmarkParallelAlgorithms);
@@ -0,0 +1,64 @@
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
+#include <functional>
+#include <string>
+
+#include "benchmarkSuite.h"
+#include "segmentedVector.h"
+#include "vector.h"
+
+// Compares appending 10M elements to a SegmentedVector against a Vector, and
+// summing a SegmentedVector by index against summing its chunks in parallel.
+
+static void _BenchmarkSegmentedVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 10'000'000;
+
+    suite.Run("push_back 10M/Vector<std::string>", [] {
+        Vector<std::string> vec;
+        for (size_t index = 0; index < numElements; ++index) {
+            vec.push_back(std::string());
+        }
+        DoNotOptimize(vec.size());
+    });
+
+    suite.Run("push_back 10M/SegmentedVector<std::string>", [] {
+        SegmentedVector<std::string> vec;
+        for (size_t index = 0; index < numElements; ++index) {
+            vec.push_back(std::string());
+        }
+        DoNotOptimize(vec.size());
+    });
+
+    SegmentedVector<int> vec(numElements, 1);
+
+    suite.Run("sum/SegmentedVector indexed", [&] {
+        size_t sum = 0;
+        for (size_t index = 0; index < vec.size(); ++index) {
+            sum += vec[index];
+        }
+        DoNotOptimize(sum);
+    });
+
+    suite.Run("sum/SegmentedVector parallel chunks", [&] {
+        size_t sum = tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, vec.chunk_count()),
+            size_t(0),
+            [&](const tbb::blocked_range<size_t>& range, size_t sum) {
+                for (size_t chunkIndex = range.begin();
+                     chunkIndex < range.end();
+                     ++chunkIndex) {
+                    for (int value : vec.chunk(chunkIndex)) {
+                        sum += value;
+                    }
+                }
+                return sum;
+            },
+            std::plus<size_t>());
+        DoNotOptimize(sum);
+    });
+}
+
+static BenchmarkRegistration s_registration("SegmentedVector",
+                                            _BenchmarkSegmentedVector);
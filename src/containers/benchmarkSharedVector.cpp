@@ -0,0 +1,104 @@
+#include <numeric>
+#include <string>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "benchmarkSuite.h"
+#include "sharedVector.h"
+#include "utils.h"
+#include "vector.h"
+
+// Compares streaming 64 MiB to a child process through a SharedVector,
+// against writing it to a pipe.
+
+// Run \p fn in a child process, which exits with the status it returns.
+template<typename FnT>
+static pid_t _ForkChild(FnT&& fn)
+{
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (pid == 0) {
+        _exit(fn());
+    }
+
+    return pid;
+}
+
+// Wait for the child process \p pid, returning its exit status.
+static int _WaitChild(pid_t pid)
+{
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static void _BenchmarkSharedVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 16 * 1024 * 1024;
+    constexpr size_t chunkSize = 64 * 1024;
+    constexpr long expectedSum =
+        long(chunkSize) * (chunkSize - 1) / 2 * (numElements / chunkSize);
+    Vector<int> chunk(chunkSize);
+    std::iota(chunk.begin(), chunk.end(), 0);
+    const std::string name =
+        "/benchmarkSharedVector" + std::to_string(getpid());
+
+    suite.Run("transfer/SharedVector", [&] {
+        SharedVector<int> writer(name, MapMode::ReadWrite);
+        pid_t pid = _ForkChild([&] {
+            SharedVector<int> reader(name);
+            while (reader.refresh() < numElements) {
+                sched_yield();
+            }
+            long sum = std::accumulate(reader.begin(), reader.end(), 0l);
+            return sum == expectedSum ? 0 : 1;
+        });
+
+        for (size_t index = 0; index < numElements; index += chunkSize) {
+            writer.append(chunk.data(), chunkSize);
+        }
+        ASSERT(_WaitChild(pid) == 0);
+        SharedVector<int>::unlink(name);
+    });
+
+    suite.Run("transfer/pipe", [&] {
+        int fds[2];
+        ASSERT(pipe(fds) == 0);
+        pid_t pid = _ForkChild([&] {
+            close(fds[1]);
+            Vector<int> received(numElements, DefaultInit);
+            char* dst = reinterpret_cast<char*>(received.data());
+            size_t remaining = sizeof(int) * numElements;
+            while (remaining > 0) {
+                ssize_t numRead = read(fds[0], dst, remaining);
+                if (numRead <= 0) {
+                    return 2;
+                }
+                dst += numRead;
+                remaining -= numRead;
+            }
+
+            long sum = std::accumulate(received.begin(), received.end(), 0l);
+            return sum == expectedSum ? 0 : 1;
+        });
+
+        close(fds[0]);
+        for (size_t index = 0; index < numElements; index += chunkSize) {
+            const char* src = reinterpret_cast<const char*>(chunk.data());
+            size_t remaining = sizeof(int) * chunkSize;
+            while (remaining > 0) {
+                ssize_t numWritten = write(fds[1], src, remaining);
+                ASSERT(numWritten > 0);
+                src += numWritten;
+                remaining -= numWritten;
+            }
+        }
+        close(fds[1]);
+        ASSERT(_WaitChild(pid) == 0);
+    });
+}
+
+static BenchmarkRegistration s_registration("SharedVector",
+                                            _BenchmarkSharedVector);
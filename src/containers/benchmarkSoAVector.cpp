@@ -0,0 +1,58 @@
+#include <span>
+
+#include "benchmarkSuite.h"
+#include "soaVector.h"
+#include "vector.h"
+
+// Compares a transform of one member in an array of structures, against the
+// same transform of one column of a SoAVector.
+
+namespace {
+
+// Test type.
+struct Vec3f
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+} // namespace
+
+template<>
+struct SoALayout<Vec3f>
+{
+    static constexpr auto members =
+        std::make_tuple(&Vec3f::x, &Vec3f::y, &Vec3f::z);
+};
+
+static void _BenchmarkSoAVector(BenchmarkSuite& suite)
+{
+    constexpr size_t numElements = 10'000'000;
+
+    Vector<Vec3f> aos;
+    SoAVector<Vec3f> soa;
+    aos.reserve(numElements);
+    soa.reserve(numElements);
+    for (size_t i = 0; i < numElements; ++i) {
+        aos.push_back(Vec3f{ float(i), float(i), float(i) });
+        soa.push_back(Vec3f{ float(i), float(i), float(i) });
+    }
+
+    suite.Run("transform x/Vector<Vec3f>", [&] {
+        for (Vec3f& value : aos) {
+            value.x = value.x * 2.0f + 1.0f;
+        }
+        DoNotOptimize(aos[numElements - 1].x);
+    });
+
+    suite.Run("transform x/SoAVector<Vec3f>", [&] {
+        std::span<float> xs = soa.column<&Vec3f::x>();
+        for (float& x : xs) {
+            x = x * 2.0f + 1.0f;
+        }
+        DoNotOptimize(xs[numElements - 1]);
+    });
+}
+
+static BenchmarkRegistration s_registration("SoAVector", _BenchmarkSoAVector);
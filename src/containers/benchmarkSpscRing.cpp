@@ -0,0 +1,133 @@
+#include <tbb/concurrent_queue.h>
+
+#include <thread>
+
+#include "benchmarkSuite.h"
+#include "spscRing.h"
+
+// Compares the throughput and hand-off latency of a SpscRing between two
+// threads, against tbb::concurrent_queue.
+
+static void _BenchmarkSpscRing(BenchmarkSuite& suite)
+{
+    // Divide the reported time by the number of elements for the cost of
+    // each element.
+    constexpr int numElements = 10'000'000;
+
+    suite.Run("throughput/SpscRing push/pop", [] {
+        SpscRing<int> ring(1024);
+        std::thread producer([&] {
+            for (int index = 0; index < numElements; ++index) {
+                while (!ring.try_push(index)) {
+                }
+            }
+        });
+
+        long sum = 0;
+        int value = 0;
+        for (int index = 0; index < numElements; ++index) {
+            while (!ring.try_pop(value)) {
+            }
+            sum += value;
+        }
+        producer.join();
+        DoNotOptimize(sum);
+    });
+
+    suite.Run("throughput/SpscRing push_batch/pop_batch", [] {
+        SpscRing<int> ring(1024);
+        std::thread producer([&] {
+            int batch[64];
+            for (int index = 0; index < numElements; index += 64) {
+                for (int offset = 0; offset < 64; ++offset) {
+                    batch[offset] = index + offset;
+                }
+                int pushed = 0;
+                while (pushed < 64) {
+                    pushed += ring.push_batch(batch + pushed, 64 - pushed);
+                }
+            }
+        });
+
+        long sum = 0;
+        int batch[64];
+        for (int count = 0; count < numElements;) {
+            int popped = ring.pop_batch(batch, 64);
+            for (int offset = 0; offset < popped; ++offset) {
+                sum += batch[offset];
+            }
+            count += popped;
+        }
+        producer.join();
+        DoNotOptimize(sum);
+    });
+
+    suite.Run("throughput/tbb::concurrent_queue push/pop", [] {
+        tbb::concurrent_queue<int> queue;
+        std::thread producer([&] {
+            for (int index = 0; index < numElements; ++index) {
+                queue.push(index);
+            }
+        });
+
+        long sum = 0;
+        int value = 0;
+        for (int index = 0; index < numElements; ++index) {
+            while (!queue.try_pop(value)) {
+            }
+            sum += value;
+        }
+        producer.join();
+        DoNotOptimize(sum);
+    });
+
+    // Bounce one element between two threads: the reported time divided by
+    // twice the number of round trips is the latency of each hand-off.
+    constexpr int numRoundTrips = 100'000;
+
+    suite.Run("latency/SpscRing ping-pong", [] {
+        SpscRing<int> ping(16);
+        SpscRing<int> pong(16);
+        std::thread echo([&] {
+            int value = 0;
+            for (int trip = 0; trip < numRoundTrips; ++trip) {
+                while (!ping.try_pop(value)) {
+                }
+                pong.try_push(value);
+            }
+        });
+
+        int value = 0;
+        for (int trip = 0; trip < numRoundTrips; ++trip) {
+            ping.try_push(trip);
+            while (!pong.try_pop(value)) {
+            }
+        }
+        echo.join();
+        DoNotOptimize(value);
+    });
+
+    suite.Run("latency/tbb::concurrent_queue ping-pong", [] {
+        tbb::concurrent_queue<int> ping;
+        tbb::concurrent_queue<int> pong;
+        std::thread echo([&] {
+            int value = 0;
+            for (int trip = 0; trip < numRoundTrips; ++trip) {
+                while (!ping.try_pop(value)) {
+                }
+                pong.push(value);
+            }
+        });
+
+        int value = 0;
+        for (int trip = 0; trip < numRoundTrips; ++trip) {
+            ping.push(trip);
+            while (!pong.try_pop(value)) {
+            }
+        }
+        echo.join();
+        DoNotOptimize(value);
+    });
+}
+
+static BenchmarkRegistration s_registration("SpscRing", _BenchmarkSpscRing);
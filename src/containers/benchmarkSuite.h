@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Prevent the compiler from optimizing away the computation of \p value.
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/// \class BenchmarkResult
+///
+/// Timing statistics of a benchmark over repeated trials, in nanoseconds.
+struct BenchmarkResult
+{
+    std::string name;
+    std::size_t trials = 0;
+    double medianNs = 0.0;
+    double p99Ns = 0.0;
+    double minNs = 0.0;
+    double meanNs = 0.0;
+};
+
+/// \class BenchmarkSuite
+///
+/// Minimal benchmark harness: runs each benchmark for a number of trials,
+/// reports the median and 99th percentile durations, and optionally writes
+/// all results as JSON for comparison across builds.
+///
+/// Benchmarks are grouped by the file defining them, and each group is added
+/// to the single benchmark program with a \ref BenchmarkRegistration.
+///
+/// Recognized command line arguments:
+/// - \p --trials \p N: the number of timed trials per benchmark.
+/// - \p --filter \p TEXT: only run benchmarks whose name contains \p TEXT.
+/// - \p --json \p PATH: write the results to \p PATH.
+class BenchmarkSuite
+{
+public:
+    /// Constructs a suite, configured from the command line.
+    BenchmarkSuite(int argc, char** argv)
+    {
+        for (int i = 1; i + 1 < argc; i += 2) {
+            if (strcmp(argv[i], "--trials") == 0) {
+                m_trials = std::max(atoi(argv[i + 1]), 1);
+            } else if (strcmp(argv[i], "--filter") == 0) {
+                m_filter = argv[i + 1];
+            } else if (strcmp(argv[i], "--json") == 0) {
+                m_jsonPath = argv[i + 1];
+            }
+        }
+
+        printf("%-56s %8s %12s %12s %12s\n",
+               "benchmark",
+               "trials",
+               "median (us)",
+               "p99 (us)",
+               "min (us)");
+    }
+
+    /// Time \p body, which receives the state produced by a fresh call to
+    /// \p setup before each trial.  Only \p body is timed.
+    ///
+    /// \param name The benchmark name.
+    /// \param setup Produces the input of each trial.
+    /// \param body The code to time.
+    template<typename SetupFnT, typename BodyFnT>
+    void Run(const std::string& name, SetupFnT setup, BodyFnT body)
+    {
+        if (name.find(m_filter) == std::string::npos) {
+            return;
+        }
+
+        // Warm up caches and the allocator.
+        {
+            auto state = setup();
+            body(state);
+            DoNotOptimize(state);
+        }
+
+        std::vector<double> durations;
+        durations.reserve(m_trials);
+        for (int trial = 0; trial < m_trials; ++trial) {
+            auto state = setup();
+            auto start = std::chrono::steady_clock::now();
+            body(state);
+            DoNotOptimize(state);
+            auto stop = std::chrono::steady_clock::now();
+            durations.push_back(
+                std::chrono::duration<double, std::nano>(stop - start).count());
+        }
+
+        m_results.push_back(_Summarize(name, durations));
+        const BenchmarkResult& result = m_results.back();
+        printf("%-56s %8zu %12.1f %12.1f %12.1f\n",
+               result.name.c_str(),
+               result.trials,
+               result.medianNs / 1e3,
+               result.p99Ns / 1e3,
+               result.minNs / 1e3);
+    }
+
+    /// Time \p body, which takes no input.
+    ///
+    /// \param name The benchmark name.
+    /// \param body The code to time.
+    template<typename BodyFnT>
+    void Run(const std::string& name, BodyFnT body)
+    {
+        Run(
+            name, [] { return 0; }, [&](int&) { body(); });
+    }
+
+    /// Write the results as JSON, if requested.
+    ///
+    /// \return The process exit code.
+    int Finish() const
+    {
+        if (m_jsonPath.empty()) {
+            return EXIT_SUCCESS;
+        }
+
+        FILE* file = fopen(m_jsonPath.c_str(), "w");
+        if (file == nullptr) {
+            fprintf(stderr, "Failed to open '%s'.\n", m_jsonPath.c_str());
+            return EXIT_FAILURE;
+        }
+
+        fprintf(file, "{\n  \"benchmarks\": [");
+        for (std::size_t index = 0; index < m_results.size(); ++index) {
+            const BenchmarkResult& result = m_results[index];
+            fprintf(file,
+                    "%s\n    {\"name\": \"%s\", \"trials\": %zu, "
+                    "\"median_ns\": %.1f, \"p99_ns\": %.1f, "
+                    "\"min_ns\": %.1f, \"mean_ns\": %.1f}",
+                    index == 0 ? "" : ",",
+                    _EscapeJson(result.name).c_str(),
+                    result.trials,
+                    result.medianNs,
+                    result.p99Ns,
+                    result.minNs,
+                    result.meanNs);
+        }
+        fprintf(file, "\n  ]\n}\n");
+        fclose(file);
+
+        return EXIT_SUCCESS;
+    }
+
+private:
+    // Compute the statistics of \p durations.
+    static BenchmarkResult _Summarize(const std::string& name,
+                                      std::vector<double>& durations)
+    {
+        std::sort(durations.begin(), durations.end());
+
+        BenchmarkResult result;
+        result.name = name;
+        result.trials = durations.size();
+        result.medianNs = durations[durations.size() / 2];
+        if (durations.size() % 2 == 0) {
+            result.medianNs =
+                (result.medianNs + durations[durations.size() / 2 - 1]) / 2;
+        }
+
+        // Nearest-rank percentile.
+        std::size_t p99Rank = std::ceil(0.99 * durations.size());
+        result.p99Ns = durations[p99Rank - 1];
+        result.minNs = durations.front();
+
+        for (double duration : durations) {
+            result.meanNs += duration;
+        }
+        result.meanNs /= durations.size();
+
+        return result;
+    }
+
+    // Escape \p string for inclusion in a JSON string literal.
+    static std::string _EscapeJson(const std::string& string)
+    {
+        std::string escaped;
+        for (char c : string) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    int m_trials = 20;
+    std::string m_filter;
+    std::string m_jsonPath;
+    std::vector<BenchmarkResult> m_results;
+};
+
+/// Signature of a function which runs a group of benchmarks.
+using BenchmarkGroupFn = void (*)(BenchmarkSuite& suite);
+
+/// Get the benchmark groups added by \ref BenchmarkRegistration, by name.
+inline std::vector<std::pair<std::string, BenchmarkGroupFn>>& BenchmarkGroups()
+{
+    static std::vector<std::pair<std::string, BenchmarkGroupFn>> groups;
+    return groups;
+}
+
+/// \class BenchmarkRegistration
+///
+/// Adds a group of benchmarks to the program during static initialization.
+/// Define one at namespace scope in each benchmark source file.
+struct BenchmarkRegistration
+{
+    /// Add the group \p name, run by \p fn.
+    BenchmarkRegistration(const char* name, BenchmarkGroupFn fn)
+    {
+        BenchmarkGroups().emplace_back(name, fn);
+    }
+};
+
+/// Run every registered benchmark group with \p suite, in order of name,
+/// as static initialization order across files is unspecified.
+///
+/// \param suite The suite to run the benchmarks with.
+inline void RunBenchmarkGroups(BenchmarkSuite& suite)
+{
+    std::vector<std::pair<std::string, BenchmarkGroupFn>> groups =
+        BenchmarkGroups();
+    std::sort(groups.begin(), groups.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const std::pair<std::string, BenchmarkGroupFn>& group : groups) {
+        group.second(suite);
+    }
+}
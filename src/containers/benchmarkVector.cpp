@@ -0,0 +1,146 @@
+#include <string>
+#include <vector>
+
+#include "benchmarkSuite.h"
+#include "vector.h"
+
+// Compares Vector against std::vector across the element types exercised by
+// testVector.cpp.
+
+// Number of elements in each benchmarked container.
+static constexpr size_t s_numElements = 1'000'000;
+
+// Test type.
+struct Vec3f
+{
+    Vec3f() = default;
+
+    explicit Vec3f(float _x, float _y, float _z)
+      : x(_x)
+      , y(_y)
+      , z(_z)
+    {}
+
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+// Make a distinct value for \p index.
+template<typename ValueT>
+static ValueT _MakeValue(size_t index)
+{
+    if constexpr (std::is_same<ValueT, std::string>::value) {
+        return std::to_string(index);
+    } else if constexpr (std::is_same<ValueT, Vec3f>::value) {
+        return Vec3f(index, index, index);
+    } else {
+        return ValueT(index);
+    }
+}
+
+// Reduce \p value to a number, so that iteration has work to do.
+template<typename ValueT>
+static double _Reduce(const ValueT& value)
+{
+    if constexpr (std::is_same<ValueT, std::string>::value) {
+        return value.size();
+    } else if constexpr (std::is_same<ValueT, Vec3f>::value) {
+        return value.x + value.y + value.z;
+    } else {
+        return value;
+    }
+}
+
+// Make a container of \p count distinct values.
+template<typename VectorT>
+static VectorT _MakeVector(size_t count)
+{
+    VectorT vec;
+    vec.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        vec.push_back(_MakeValue<typename VectorT::value_type>(i));
+    }
+    return vec;
+}
+
+// Run every operation against \p VectorT, whose name is \p typeName.
+template<typename VectorT>
+static void _BenchmarkVector(BenchmarkSuite& suite, const std::string& typeName)
+{
+    using ValueT = typename VectorT::value_type;
+    constexpr size_t numElements = s_numElements;
+
+    suite.Run("push_back/" + typeName, [] {
+        VectorT vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(_MakeValue<ValueT>(i));
+        }
+        DoNotOptimize(vec.data());
+    });
+
+    // Insert a range of 10% of the elements in the middle.
+    suite.Run(
+        "insert/" + typeName,
+        [] {
+            return std::make_pair(_MakeVector<VectorT>(numElements),
+                                  _MakeVector<VectorT>(numElements / 10));
+        },
+        [](std::pair<VectorT, VectorT>& state) {
+            VectorT& vec = state.first;
+            vec.insert(vec.begin() + vec.size() / 2,
+                       state.second.begin(),
+                       state.second.end());
+            DoNotOptimize(vec.data());
+        });
+
+    // Erase a range of 10% of the elements from the middle.
+    suite.Run(
+        "erase/" + typeName,
+        [] { return _MakeVector<VectorT>(numElements); },
+        [](VectorT& vec) {
+            auto first = vec.begin() + vec.size() / 2;
+            vec.erase(first, first + vec.size() / 10);
+            DoNotOptimize(vec.data());
+        });
+
+    suite.Run(
+        "copy/" + typeName,
+        [] { return _MakeVector<VectorT>(numElements); },
+        [](VectorT& vec) {
+            VectorT copy(vec);
+            DoNotOptimize(copy.data());
+        });
+
+    suite.Run("resize/" + typeName, [] {
+        VectorT vec;
+        vec.resize(numElements);
+        DoNotOptimize(vec.data());
+    });
+
+    suite.Run(
+        "iteration/" + typeName,
+        [] { return _MakeVector<VectorT>(numElements); },
+        [](VectorT& vec) {
+            double sum = 0.0;
+            for (const ValueT& value : vec) {
+                sum += _Reduce(value);
+            }
+            DoNotOptimize(sum);
+        });
+}
+
+static void _BenchmarkVectors(BenchmarkSuite& suite)
+{
+    _BenchmarkVector<std::vector<int>>(suite, "std::vector<int>");
+    _BenchmarkVector<Vector<int>>(suite, "Vector<int>");
+    _BenchmarkVector<std::vector<float>>(suite, "std::vector<float>");
+    _BenchmarkVector<Vector<float>>(suite, "Vector<float>");
+    _BenchmarkVector<std::vector<Vec3f>>(suite, "std::vector<Vec3f>");
+    _BenchmarkVector<Vector<Vec3f>>(suite, "Vector<Vec3f>");
+    _BenchmarkVector<std::vector<std::string>>(suite,
+                                               "std::vector<std::string>");
+    _BenchmarkVector<Vector<std::string>>(suite, "Vector<std::string>");
+}
+
+static BenchmarkRegistration s_registration("Vector", _BenchmarkVectors);
@@ -0,0 +1,452 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "vector.h"
+
+/// \class BitVector
+///
+/// A dynamic array of bits, packed 64 to a word.
+///
+/// Bitwise operations process whole words over cache line aligned storage
+/// (see \ref DefaultAlignment), in loops simple enough for the compiler to
+/// vectorize.  Bits past \ref size in the last word are kept zero, so that
+/// whole-word operations never need masking.
+///
+/// \ref rank and \ref select are accelerated by an index of the number of
+/// set bits preceding every 512-bit block, which is built by
+/// \ref build_rank_index and must be rebuilt after the bits change.
+class BitVector
+{
+public:
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef word_type
+    ///
+    /// The storage type of each group of 64 bits.
+    using word_type = std::uint64_t;
+
+    /// The number of bits in a word.
+    static constexpr size_type word_bits = 64;
+
+    /// Returned by searches which find no bit.
+    static constexpr size_type npos = size_type(-1);
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Constructs an empty bit vector.
+    BitVector() = default;
+
+    /// Constructs a bit vector of \p count bits, each set to \p value.
+    ///
+    /// \param count The number of bits.
+    /// \param value The value of each bit.
+    explicit BitVector(size_type count, bool value = false)
+    {
+        resize(count, value);
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Get the value of a bit.
+    ///
+    /// \param index The index of the bit.
+    bool operator[](size_type index) const { return test(index); }
+
+    /// Get the value of a bit.
+    ///
+    /// \param index The index of the bit.
+    bool test(size_type index) const
+    {
+        return (m_words[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    /// Get the value of a bit with bounds checking.
+    ///
+    /// \param index The index of the bit.
+    bool at(size_type index) const
+    {
+        if (index >= m_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return test(index);
+    }
+
+    /// Set a bit to \p value.
+    ///
+    /// \param index The index of the bit.
+    /// \param value The value of the bit.
+    void set(size_type index, bool value = true)
+    {
+        word_type mask = word_type(1) << (index % word_bits);
+        word_type& word = m_words[index / word_bits];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    /// Clear a bit.
+    ///
+    /// \param index The index of the bit.
+    void reset(size_type index)
+    {
+        m_words[index / word_bits] &= ~(word_type(1) << (index % word_bits));
+    }
+
+    /// Toggle a bit.
+    ///
+    /// \param index The index of the bit.
+    void flip(size_type index)
+    {
+        m_words[index / word_bits] ^= word_type(1) << (index % word_bits);
+    }
+
+    /// Access the words storing the bits, in a read-only fashion.
+    const word_type* words() const { return m_words.data(); }
+
+    /// Access the words storing the bits, in a mutable fashion.  Bits past
+    /// \ref size must be left zero.
+    word_type* words() { return m_words.data(); }
+
+    /// Get the number of words storing the bits.
+    size_type word_count() const { return m_words.size(); }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if there are no bits.
+    bool empty() const { return m_size == 0; }
+
+    /// Get the number of bits.
+    size_type size() const { return m_size; }
+
+    /// Allocate storage for at least \p count bits.
+    ///
+    /// \param count The number of bits.
+    void reserve(size_type count) { m_words.reserve(_WordCount(count)); }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Append a bit.
+    ///
+    /// \param value The value of the bit.
+    void push_back(bool value)
+    {
+        if (m_size % word_bits == 0) {
+            m_words.push_back(0);
+        }
+        m_size++;
+        set(m_size - 1, value);
+    }
+
+    /// Resize to \p count bits, setting new bits to \p value.
+    ///
+    /// \param count The number of bits.
+    /// \param value The value of new bits.
+    void resize(size_type count, bool value = false)
+    {
+        if (value && count > m_size) {
+            // Fill the remainder of the current last word.
+            size_type tailEnd =
+                std::min(count, _WordCount(m_size) * word_bits);
+            for (size_type index = m_size; index < tailEnd; ++index) {
+                set(index);
+            }
+        }
+
+        m_words.resize(_WordCount(count), value ? ~word_type(0) : 0);
+        m_size = count;
+        _ClearTail();
+    }
+
+    /// Remove all bits.
+    void clear()
+    {
+        m_words.clear();
+        m_size = 0;
+    }
+
+    /// Set every bit.
+    void set()
+    {
+        std::fill(m_words.begin(), m_words.end(), ~word_type(0));
+        _ClearTail();
+    }
+
+    /// Clear every bit.
+    void reset() { std::fill(m_words.begin(), m_words.end(), word_type(0)); }
+
+    /// Toggle every bit.
+    void flip()
+    {
+        word_type* words = m_words.data();
+        for (size_type index = 0; index < m_words.size(); ++index) {
+            words[index] = ~words[index];
+        }
+        _ClearTail();
+    }
+
+    /// Bitwise-and \p other into this bit vector, of the same size.
+    ///
+    /// \param other The other bit vector.
+    BitVector& operator&=(const BitVector& other)
+    {
+        _Combine(other, [](word_type lhs, word_type rhs) { return lhs & rhs; });
+        return *this;
+    }
+
+    /// Bitwise-or \p other into this bit vector, of the same size.
+    ///
+    /// \param other The other bit vector.
+    BitVector& operator|=(const BitVector& other)
+    {
+        _Combine(other, [](word_type lhs, word_type rhs) { return lhs | rhs; });
+        return *this;
+    }
+
+    /// Bitwise-xor \p other into this bit vector, of the same size.
+    ///
+    /// \param other The other bit vector.
+    BitVector& operator^=(const BitVector& other)
+    {
+        _Combine(other, [](word_type lhs, word_type rhs) { return lhs ^ rhs; });
+        return *this;
+    }
+
+    /// Get the bitwise complement.
+    BitVector operator~() const
+    {
+        BitVector result(*this);
+        result.flip();
+        return result;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Queries
+    // -----------------------------------------------------------------------
+
+    /// Get the number of set bits.
+    size_type count() const
+    {
+        const word_type* words = m_words.data();
+        size_type total = 0;
+        for (size_type index = 0; index < m_words.size(); ++index) {
+            total += std::popcount(words[index]);
+        }
+        return total;
+    }
+
+    /// Check if any bit is set.
+    bool any() const
+    {
+        return std::any_of(
+            m_words.begin(), m_words.end(), [](word_type w) { return w != 0; });
+    }
+
+    /// Check if no bit is set.
+    bool none() const { return !any(); }
+
+    /// Check if every bit is set.
+    bool all() const { return count() == m_size; }
+
+    /// Find the first set bit.
+    ///
+    /// \return The index of the bit, or \ref npos if none is set.
+    size_type find_first() const
+    {
+        return m_words.empty() ? npos : _FindFrom(0, m_words[0]);
+    }
+
+    /// Find the first set bit after \p index.
+    ///
+    /// \param index The index to search after.
+    ///
+    /// \return The index of the bit, or \ref npos if none is set.
+    size_type find_next(size_type index) const
+    {
+        index++;
+        if (index >= m_size) {
+            return npos;
+        }
+
+        size_type wordIndex = index / word_bits;
+        return _FindFrom(wordIndex,
+                         m_words[wordIndex] & (~word_type(0)
+                                               << (index % word_bits)));
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Rank and select
+    // -----------------------------------------------------------------------
+
+    /// Build the index used by \ref rank and \ref select, of the current
+    /// bits.
+    void build_rank_index()
+    {
+        size_type blockCount =
+            (m_words.size() + s_blockWords - 1) / s_blockWords;
+        m_blockRanks.resize(blockCount + 1, DefaultInit);
+
+        const word_type* words = m_words.data();
+        size_type total = 0;
+        for (size_type block = 0; block < blockCount; ++block) {
+            m_blockRanks[block] = total;
+            size_type last =
+                std::min(m_words.size(), (block + 1) * s_blockWords);
+            for (size_type index = block * s_blockWords; index < last;
+                 ++index) {
+                total += std::popcount(words[index]);
+            }
+        }
+        m_blockRanks[blockCount] = total;
+    }
+
+    /// Count the set bits before \p index.  Requires an up-to-date rank
+    /// index.
+    ///
+    /// \param index The index to count up to, at most \ref size.
+    ///
+    /// \return The number of set bits in [0, \p index).
+    size_type rank(size_type index) const
+    {
+        size_type wordIndex = index / word_bits;
+        size_type block = wordIndex / s_blockWords;
+        size_type total = m_blockRanks[block];
+        for (size_type w = block * s_blockWords; w < wordIndex; ++w) {
+            total += std::popcount(m_words[w]);
+        }
+
+        size_type bit = index % word_bits;
+        if (bit != 0) {
+            total += std::popcount(m_words[wordIndex] &
+                                   ((word_type(1) << bit) - 1));
+        }
+        return total;
+    }
+
+    /// Find the set bit preceded by \p count set bits.  Requires an
+    /// up-to-date rank index.
+    ///
+    /// \param count The number of set bits preceding the bit.
+    ///
+    /// \return The index of the bit, or \ref npos if fewer than \p count + 1
+    /// bits are set.
+    size_type select(size_type count) const
+    {
+        if (m_blockRanks.empty() || count >= m_blockRanks.back()) {
+            return npos;
+        }
+
+        // The block is the last one starting with at most count set bits.
+        size_type block =
+            std::upper_bound(m_blockRanks.begin(), m_blockRanks.end(), count) -
+            m_blockRanks.begin() - 1;
+        count -= m_blockRanks[block];
+
+        size_type wordIndex = block * s_blockWords;
+        for (;; ++wordIndex) {
+            size_type wordCount = std::popcount(m_words[wordIndex]);
+            if (count < wordCount) {
+                break;
+            }
+            count -= wordCount;
+        }
+
+        // Drop the lowest set bits of the word, then take the next one.
+        word_type word = m_words[wordIndex];
+        for (; count > 0; --count) {
+            word &= word - 1;
+        }
+        return wordIndex * word_bits + std::countr_zero(word);
+    }
+
+    /// Check if two bit vectors hold the same bits.
+    bool operator==(const BitVector& other) const
+    {
+        return m_size == other.m_size &&
+               std::equal(
+                   m_words.begin(), m_words.end(), other.m_words.begin());
+    }
+
+private:
+    // Number of words in each block of the rank index.
+    static constexpr size_type s_blockWords = 8;
+
+    static constexpr size_type _WordCount(size_type count)
+    {
+        return (count + word_bits - 1) / word_bits;
+    }
+
+    // Zero the bits of the last word past the size.
+    void _ClearTail()
+    {
+        size_type bit = m_size % word_bits;
+        if (bit != 0) {
+            m_words.back() &= (word_type(1) << bit) - 1;
+        }
+    }
+
+    // Find the first set bit of \p word, or of a later word.
+    size_type _FindFrom(size_type wordIndex, word_type word) const
+    {
+        while (word == 0) {
+            if (++wordIndex == m_words.size()) {
+                return npos;
+            }
+            word = m_words[wordIndex];
+        }
+        return wordIndex * word_bits + std::countr_zero(word);
+    }
+
+    // Combine the words of \p other into these with \p op.
+    template<typename OpT>
+    void _Combine(const BitVector& other, OpT op)
+    {
+        if (other.m_size != m_size) {
+            throw std::invalid_argument("Bit vector sizes differ.");
+        }
+
+        word_type* lhs = m_words.data();
+        const word_type* rhs = other.m_words.data();
+        for (size_type index = 0; index < m_words.size(); ++index) {
+            lhs[index] = op(lhs[index], rhs[index]);
+        }
+    }
+
+    Vector<word_type> m_words;
+    size_type m_size = 0;
+
+    // Number of set bits preceding each block, followed by the total.
+    Vector<size_type> m_blockRanks;
+};
+
+/// Bitwise-and two bit vectors of the same size.
+inline BitVector operator&(BitVector lhs, const BitVector& rhs)
+{
+    return lhs &= rhs;
+}
+
+/// Bitwise-or two bit vectors of the same size.
+inline BitVector operator|(BitVector lhs, const BitVector& rhs)
+{
+    return lhs |= rhs;
+}
+
+/// Bitwise-xor two bit vectors of the same size.
+inline BitVector operator^(BitVector lhs, const BitVector& rhs)
+{
+    return lhs ^= rhs;
+}
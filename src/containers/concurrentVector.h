@@ -0,0 +1,519 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+
+/// \class ConcurrentVector
+///
+/// An append-only array which many threads may grow at once, without locks.
+///
+/// Elements live in a fixed table of segments whose sizes are successive
+/// powers of two, so that growing never moves existing elements: references
+/// to them remain valid until the vector is cleared or destroyed.  Appends
+/// claim indices with a compare-and-swap on the size, only once the segments
+/// holding them are allocated, so that a failed allocation claims nothing.
+/// A missing segment is allocated by whichever thread first needs it,
+/// published with a compare-and-swap (losing threads free their allocation).
+///
+/// The size counts claimed indices, and so may include elements which are
+/// still being constructed by other threads: reading elements appended
+/// concurrently must be synchronized by the caller, for example by joining
+/// the appending threads.  Exceptions thrown by element constructors during
+/// concurrent growth terminate the program.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam AllocatorT Allocates each segment.
+template<typename ValueT, typename AllocatorT = MallocAllocator<ValueT>>
+class ConcurrentVector
+{
+    // Number of elements in the first segment: at least a page, as small
+    // segments make early appends contend on allocation.
+    static constexpr std::size_t s_firstSegmentSize =
+        std::bit_ceil(std::max<std::size_t>(8, 4096 / sizeof(ValueT)));
+
+    static constexpr int s_firstSegmentLog2 =
+        std::countr_zero(s_firstSegmentSize);
+
+    // Number of segments needed to address every index.
+    static constexpr int s_numSegments = 64 - s_firstSegmentLog2;
+
+    // Random access iterator over the elements, in a mutable or read-only
+    // fashion, which re-computes the segment of each accessed index.
+    template<typename VectorT, typename ElementT>
+    class _Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<ElementT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ElementT*;
+        using reference = ElementT&;
+
+        _Iterator() = default;
+
+        _Iterator(VectorT* vector, std::size_t index)
+          : m_vector(vector)
+          , m_index(index)
+        {}
+
+        /// Converting constructor, from a mutable to a read-only iterator.
+        template<typename OtherVectorT, typename OtherElementT>
+        _Iterator(const _Iterator<OtherVectorT, OtherElementT>& other)
+            requires(std::is_const_v<ElementT> &&
+                     !std::is_const_v<OtherElementT>)
+          : m_vector(other.m_vector)
+          , m_index(other.m_index)
+        {}
+
+        reference operator*() const { return (*m_vector)[m_index]; }
+
+        pointer operator->() const { return &(*m_vector)[m_index]; }
+
+        reference operator[](difference_type offset) const
+        {
+            return (*m_vector)[m_index + offset];
+        }
+
+        _Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        _Iterator operator++(int)
+        {
+            _Iterator copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        _Iterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        _Iterator operator--(int)
+        {
+            _Iterator copy = *this;
+            --m_index;
+            return copy;
+        }
+
+        _Iterator& operator+=(difference_type offset)
+        {
+            m_index += offset;
+            return *this;
+        }
+
+        _Iterator& operator-=(difference_type offset)
+        {
+            m_index -= offset;
+            return *this;
+        }
+
+        _Iterator operator+(difference_type offset) const
+        {
+            return _Iterator(m_vector, m_index + offset);
+        }
+
+        friend _Iterator operator+(difference_type offset,
+                                   const _Iterator& iterator)
+        {
+            return iterator + offset;
+        }
+
+        _Iterator operator-(difference_type offset) const
+        {
+            return _Iterator(m_vector, m_index - offset);
+        }
+
+        difference_type operator-(const _Iterator& other) const
+        {
+            return difference_type(m_index) - difference_type(other.m_index);
+        }
+
+        bool operator==(const _Iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        auto operator<=>(const _Iterator& other) const
+        {
+            return m_index <=> other.m_index;
+        }
+
+    private:
+        template<typename, typename>
+        friend class _Iterator;
+
+        VectorT* m_vector = nullptr;
+        std::size_t m_index = 0;
+    };
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef allocator_type
+    ///
+    /// The allocator type.
+    using allocator_type = AllocatorT;
+
+    /// \typedef iterator
+    ///
+    /// Iterator over the elements, in a mutable fashion.
+    using iterator = _Iterator<ConcurrentVector, value_type>;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the elements, in a read-only fashion.
+    using const_iterator = _Iterator<const ConcurrentVector, const value_type>;
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Default constructor.
+    ConcurrentVector() = default;
+
+    /// Constructs an empty vector, with an allocator instance.
+    ///
+    /// \param allocator The allocator instance.
+    explicit ConcurrentVector(const AllocatorT& allocator)
+      : m_allocator(allocator)
+    {}
+
+    /// Destroys the elements, and frees the segments.
+    ~ConcurrentVector()
+    {
+        clear();
+        for (int segment = 0; segment < s_numSegments; ++segment) {
+            value_type* buffer =
+                m_segments[segment].load(std::memory_order_relaxed);
+            if (buffer != nullptr) {
+                m_allocator.deallocate(buffer, _SegmentSize(segment));
+            }
+        }
+    }
+
+    /// Move constructor.  Must not race with other operations on \p src.
+    ///
+    /// \param src The source vector to move the segments from.
+    ConcurrentVector(ConcurrentVector&& src) noexcept
+      : m_allocator(src.m_allocator)
+      , m_size(src.m_size.exchange(0, std::memory_order_relaxed))
+    {
+        for (int segment = 0; segment < s_numSegments; ++segment) {
+            m_segments[segment].store(
+                src.m_segments[segment].exchange(nullptr,
+                                                 std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+    }
+
+    // Element addresses are stable for the lifetime of the vector.
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(ConcurrentVector&&) = delete;
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access an element, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& operator[](size_type index) const
+    {
+        auto [segment, offset] = _Locate(index);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    /// Access an element, in a mutable fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    value_type& operator[](size_type index)
+    {
+        auto [segment, offset] = _Locate(index);
+        return m_segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    /// Access an element with bounds checking, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return (*this)[index];
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Iterators
+    // -----------------------------------------------------------------------
+
+    /// Get an iterator to the first element, in a mutable fashion.
+    iterator begin() { return iterator(this, 0); }
+
+    /// Get an iterator past the last element, in a mutable fashion.
+    iterator end() { return iterator(this, size()); }
+
+    /// Get an iterator to the first element, in a read-only fashion.
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    /// Get an iterator past the last element, in a read-only fashion.
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if no indices have been claimed.
+    bool empty() const { return size() == 0; }
+
+    /// Get the number of claimed indices, including elements which may still
+    /// be under construction by other threads.
+    size_type size() const { return m_size.load(std::memory_order_acquire); }
+
+    /// Get the number of elements which fit in the leading allocated
+    /// segments.
+    size_type capacity() const
+    {
+        int segment = 0;
+        while (segment < s_numSegments &&
+               m_segments[segment].load(std::memory_order_acquire) !=
+                   nullptr) {
+            ++segment;
+        }
+
+        return _SegmentStart(segment);
+    }
+
+    /// Allocate the segments holding the first \p count elements.  Safe to
+    /// call concurrently with growth.
+    ///
+    /// \param count The number of elements.
+    void reserve(size_type count)
+    {
+        if (count != 0) {
+            _ReserveSegments(0, _Locate(count - 1).first);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Append an element constructed in-place with \p args.  Safe to call
+    /// concurrently with other appends.
+    ///
+    /// \param args The constructor arguments.
+    ///
+    /// \return Iterator to the new element.
+    template<typename... ArgsT>
+    iterator emplace_back(ArgsT&&... args)
+    {
+        size_type index = _Claim(1);
+        auto [segment, offset] = _Locate(index);
+        _Construct(_AcquireSegment(segment) + offset,
+                   std::forward<ArgsT>(args)...);
+        return iterator(this, index);
+    }
+
+    /// Append a copy of \p value.  Safe to call concurrently with other
+    /// appends.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Iterator to the new element.
+    iterator push_back(const value_type& value) { return emplace_back(value); }
+
+    /// Append \p value by move.  Safe to call concurrently with other
+    /// appends.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Iterator to the new element.
+    iterator push_back(value_type&& value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    /// Append \p count value-initialized elements, at consecutive indices.
+    /// Safe to call concurrently with other appends.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return Iterator to the first new element.
+    iterator grow_by(size_type count)
+    {
+        return _GrowBy(count, [](value_type* ptr) { _Construct(ptr); });
+    }
+
+    /// Append \p count copies of \p value, at consecutive indices.  Safe to
+    /// call concurrently with other appends.
+    ///
+    /// \param count The number of elements.
+    /// \param value The element value.
+    ///
+    /// \return Iterator to the first new element.
+    iterator grow_by(size_type count, const value_type& value)
+    {
+        return _GrowBy(count,
+                       [&](value_type* ptr) { _Construct(ptr, value); });
+    }
+
+    /// Destroy all elements, keeping the segments allocated.  Must not race
+    /// with any other operation.
+    void clear()
+    {
+        size_type count = m_size.exchange(0, std::memory_order_acq_rel);
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            _ForEachInRange(0, count, [](value_type* ptr) {
+                std::destroy_at(ptr);
+            });
+        }
+    }
+
+private:
+    // Index of the first element of \p segment.
+    static constexpr size_type _SegmentStart(int segment)
+    {
+        return (s_firstSegmentSize << segment) - s_firstSegmentSize;
+    }
+
+    // Number of elements in \p segment.
+    static constexpr size_type _SegmentSize(int segment)
+    {
+        return s_firstSegmentSize << segment;
+    }
+
+    // Get the segment holding \p index, and the offset within it.
+    static std::pair<int, size_type> _Locate(size_type index)
+    {
+        // Or-ing in the first segment size proves to the compiler that the
+        // segment is not negative, even if the biased index wraps around.
+        size_type biased = index + s_firstSegmentSize;
+        int segment = std::bit_width(biased | s_firstSegmentSize) - 1 -
+                      s_firstSegmentLog2;
+        return { segment, biased - _SegmentSize(segment) };
+    }
+
+    // Construct an element at \p ptr from \p args.  Other threads cannot
+    // observe a failed construction, so exceptions terminate.
+    template<typename... ArgsT>
+    static void _Construct(value_type* ptr, ArgsT&&... args) noexcept
+    {
+        ::new (static_cast<void*>(ptr))
+            value_type(std::forward<ArgsT>(args)...);
+    }
+
+    // Get \p segment, allocating and publishing it if it is missing.
+    value_type* _AcquireSegment(int segment)
+    {
+        value_type* buffer =
+            m_segments[segment].load(std::memory_order_acquire);
+        if (buffer != nullptr) {
+            return buffer;
+        }
+
+        value_type* allocated = m_allocator.allocate(_SegmentSize(segment));
+        if (m_segments[segment].compare_exchange_strong(
+                buffer, allocated, std::memory_order_acq_rel)) {
+            return allocated;
+        }
+
+        // Another thread published the segment first.
+        m_allocator.deallocate(allocated, _SegmentSize(segment));
+        return buffer;
+    }
+
+    // Allocate segments \p first to \p last, inclusively.
+    void _ReserveSegments(int first, int last)
+    {
+        for (int segment = first; segment <= last; ++segment) {
+            _AcquireSegment(segment);
+        }
+    }
+
+    // Invoke \p fn with a pointer to each element of [\p first, \p last),
+    // walking one segment at a time.
+    template<typename FnT>
+    void _ForEachInRange(size_type first, size_type last, FnT&& fn)
+    {
+        while (first < last) {
+            auto [segment, offset] = _Locate(first);
+            value_type* buffer = _AcquireSegment(segment);
+            size_type count =
+                std::min(_SegmentSize(segment) - offset, last - first);
+            for (size_type index = 0; index < count; ++index) {
+                fn(buffer + offset + index);
+            }
+            first += count;
+        }
+    }
+
+    // Claim \p count consecutive indices, after allocating the segments
+    // holding them, so that the size never counts an index without storage.
+    //
+    // \return The first claimed index.
+    size_type _Claim(size_type count)
+    {
+        size_type first = m_size.load(std::memory_order_relaxed);
+        do {
+            // Usually the segments exist, and this only loads them.
+            if (count != 0) {
+                _ReserveSegments(_Locate(first).first,
+                                 _Locate(first + count - 1).first);
+            }
+        } while (!m_size.compare_exchange_weak(first,
+                                               first + count,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+        return first;
+    }
+
+    // Claim \p count consecutive indices, and construct each element with
+    // \p constructFn.
+    template<typename ConstructFnT>
+    iterator _GrowBy(size_type count, ConstructFnT&& constructFn)
+    {
+        size_type first = _Claim(count);
+        _ForEachInRange(first, first + count, constructFn);
+        return iterator(this, first);
+    }
+
+    AllocatorT m_allocator;
+
+    // Number of claimed indices.
+    std::atomic<size_type> m_size = 0;
+
+    // Segment buffers, each null until allocated.
+    std::atomic<value_type*> m_segments[s_numSegments] = {};
+};
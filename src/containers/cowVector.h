@@ -0,0 +1,366 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.h"
+#include "vector.h"
+
+/// \class CowVector
+///
+/// A copy-on-write array: copies share one buffer, and the buffer is only
+/// duplicated when a copy which shares it is first mutated.
+///
+/// Copying is a single atomic increment of the reference count of the shared
+/// buffer, so that a rarely modified vector may be snapshotted cheaply, and
+/// the snapshot read from many threads while the original keeps changing.
+/// Like \p std::shared_ptr, distinct CowVector objects sharing a buffer may
+/// be used from different threads at once, but a single CowVector object
+/// must not be mutated while another thread copies or reads it.
+///
+/// Mutation goes through the non-const members, each of which first ensures
+/// the buffer is not shared.  References obtained from them (including
+/// \ref mutable_vector) must not be written through after this vector has
+/// been copied, as the buffer is then shared with the copy.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam AllocatorT The allocator used to obtain element storage.
+template<typename ValueT, typename AllocatorT = MallocAllocator<ValueT>>
+class CowVector
+{
+public:
+    /// \typedef vector_type
+    ///
+    /// The type of the shared vector.
+    using vector_type = Vector<ValueT, AllocatorT>;
+
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the elements, in a read-only fashion.
+    using const_iterator = const value_type*;
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Constructs an empty vector, without allocating.
+    CowVector() = default;
+
+    /// Constructs a vector with \p count value-initialized elements.
+    ///
+    /// \param count The number of elements.
+    explicit CowVector(size_type count)
+      : m_block(new _Block(count))
+    {}
+
+    /// Constructs a vector with \p count copies of \p value.
+    ///
+    /// \param count The number of elements.
+    /// \param value The value of each element.
+    CowVector(size_type count, const value_type& value)
+      : m_block(new _Block(count, value))
+    {}
+
+    /// Constructs a vector from an initializer list.
+    ///
+    /// \param src The source initializer list.
+    CowVector(std::initializer_list<value_type> src)
+      : m_block(new _Block(src))
+    {}
+
+    /// Constructs a vector which adopts the elements of \p src.
+    ///
+    /// \param src The source vector to move from.
+    explicit CowVector(vector_type&& src)
+      : m_block(new _Block(std::move(src)))
+    {}
+
+    /// Copy constructor, sharing the buffer of \p src.
+    ///
+    /// \param src The source vector to share the buffer of.
+    CowVector(const CowVector& src) noexcept
+      : m_block(src.m_block)
+    {
+        _Retain();
+    }
+
+    /// Move constructor.
+    ///
+    /// \param src The source vector to take the buffer of.
+    CowVector(CowVector&& src) noexcept
+      : m_block(std::exchange(src.m_block, nullptr))
+    {}
+
+    /// Releases the shared buffer.
+    ~CowVector() { _Release(); }
+
+    /// Copy assignment, sharing the buffer of \p src.
+    ///
+    /// \param src The source vector to share the buffer of.
+    CowVector& operator=(const CowVector& src) noexcept
+    {
+        if (m_block != src.m_block) {
+            _Release();
+            m_block = src.m_block;
+            _Retain();
+        }
+        return *this;
+    }
+
+    /// Move assignment.
+    ///
+    /// \param src The source vector to take the buffer of.
+    CowVector& operator=(CowVector&& src) noexcept
+    {
+        if (this != &src) {
+            _Release();
+            m_block = std::exchange(src.m_block, nullptr);
+        }
+        return *this;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Sharing
+    // -----------------------------------------------------------------------
+
+    /// Get the number of vectors sharing the buffer, or 0 if no buffer has
+    /// been created.
+    size_type use_count() const
+    {
+        return m_block == nullptr
+                   ? 0
+                   : m_block->refCount.load(std::memory_order_acquire);
+    }
+
+    /// Check if \p other shares the buffer of this vector.
+    ///
+    /// \param other The vector to compare with.
+    bool shares_with(const CowVector& other) const
+    {
+        return m_block != nullptr && m_block == other.m_block;
+    }
+
+    /// Get the shared vector, in a read-only fashion.
+    const vector_type& vector() const
+    {
+        return m_block == nullptr ? _EmptyVector() : m_block->vector;
+    }
+
+    /// Get the vector, in a mutable fashion, copying it first if it is
+    /// shared.
+    ///
+    /// \return The vector, which is owned by this object alone.
+    vector_type& mutable_vector() { return _Detach(); }
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access an element, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& operator[](size_type index) const
+    {
+        return m_block->vector[index];
+    }
+
+    /// Access an element with bounds checking, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& at(size_type index) const
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return m_block->vector[index];
+    }
+
+    /// Access an element, in a mutable fashion, copying the buffer first if
+    /// it is shared.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    value_type& mutable_at(size_type index)
+    {
+        if (index >= size()) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return _Detach()[index];
+    }
+
+    /// Access the underlying buffer, in a read-only fashion.
+    ///
+    /// \return Pointer to the first element, or \p nullptr if no storage has
+    /// been allocated.
+    const value_type* data() const { return vector().data(); }
+
+    /// Access the first element, in a read-only fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    const value_type& front() const { return m_block->vector.front(); }
+
+    /// Access the last element, in a read-only fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    const value_type& back() const { return m_block->vector.back(); }
+
+    // -----------------------------------------------------------------------
+    /// \name Iterators
+    // -----------------------------------------------------------------------
+
+    /// Get an iterator to the first element.
+    const_iterator begin() const { return data(); }
+
+    /// Get an iterator past the last element.
+    const_iterator end() const { return data() + size(); }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if there are no elements.
+    bool empty() const { return size() == 0; }
+
+    /// Get the number of elements.
+    size_type size() const { return vector().size(); }
+
+    /// Get the number of elements which fit in the shared buffer.
+    size_type capacity() const { return vector().capacity(); }
+
+    /// Allocate storage for at least \p count elements.
+    ///
+    /// \param count The number of elements.
+    void reserve(size_type count) { _Detach().reserve(count); }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Remove all elements.  A shared buffer is released rather than copied.
+    void clear()
+    {
+        if (use_count() > 1) {
+            _Release();
+            m_block = nullptr;
+        } else if (m_block != nullptr) {
+            m_block->vector.clear();
+        }
+    }
+
+    /// Append a copy of \p value.
+    ///
+    /// \param value The element value.
+    void push_back(const value_type& value) { _Detach().push_back(value); }
+
+    /// Append \p value by move.
+    ///
+    /// \param value The element value.
+    void push_back(value_type&& value)
+    {
+        _Detach().push_back(std::move(value));
+    }
+
+    /// Append an element constructed in-place with \p args.
+    ///
+    /// \param args The constructor arguments.
+    ///
+    /// \return The new element.
+    template<typename... ArgsT>
+    value_type& emplace_back(ArgsT&&... args)
+    {
+        return _Detach().emplace_back(std::forward<ArgsT>(args)...);
+    }
+
+    /// Remove the last element.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    void pop_back() { _Detach().pop_back(); }
+
+    /// Resize to \p count elements, value-initializing new elements.
+    ///
+    /// \param count The number of elements.
+    void resize(size_type count) { _Detach().resize(count); }
+
+    /// Resize to \p count elements, initializing new elements to \p value.
+    ///
+    /// \param count The number of elements.
+    /// \param value The value of new elements.
+    void resize(size_type count, const value_type& value)
+    {
+        _Detach().resize(count, value);
+    }
+
+private:
+    // The shared vector, and the number of CowVectors sharing it.
+    struct _Block
+    {
+        template<typename... ArgsT>
+        explicit _Block(ArgsT&&... args)
+          : vector(std::forward<ArgsT>(args)...)
+        {}
+
+        std::atomic<size_type> refCount = 1;
+        vector_type vector;
+    };
+
+    // An empty vector to read from, before a buffer is created.
+    static const vector_type& _EmptyVector()
+    {
+        static const vector_type empty;
+        return empty;
+    }
+
+    void _Retain()
+    {
+        if (m_block != nullptr) {
+            m_block->refCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // The last owner deletes the block, after every other owner's reads.
+    void _Release()
+    {
+        if (m_block != nullptr &&
+            m_block->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete m_block;
+        }
+    }
+
+    // Make this object the sole owner of a buffer, creating or copying it
+    // as needed.  Observing a reference count of 1 with acquire ordering
+    // orders the writes which follow after the reads of released sharers.
+    vector_type& _Detach()
+    {
+        if (m_block == nullptr) {
+            m_block = new _Block();
+        } else if (m_block->refCount.load(std::memory_order_acquire) != 1) {
+            _Block* copy = new _Block(m_block->vector);
+            _Release();
+            m_block = copy;
+        }
+
+        return m_block->vector;
+    }
+
+    _Block* m_block = nullptr;
+};
@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+/// \enum FlatMapLayout
+///
+/// The order in which a \ref FlatMap stores its keys.
+enum class FlatMapLayout
+{
+    /// Ascending order, searched by a branchless binary search.
+    Sorted,
+
+    /// Breadth-first order of an implicit binary search tree (the Eytzinger
+    /// layout), in which the next few levels of a search are adjacent in
+    /// memory and can be prefetched.
+    Eytzinger,
+};
+
+/// \class FlatMap
+///
+/// A read-mostly associative array which stores its keys contiguously in a
+/// \ref Vector, and its values in a parallel \ref Vector, so that lookups
+/// touch no pointers.
+///
+/// The map is typically bulk built from unsorted pairs.  With the
+/// \ref FlatMapLayout::Sorted layout, single keys may also be inserted and
+/// erased, at linear cost.  The \ref FlatMapLayout::Eytzinger layout is
+/// immutable once built, and its entries are stored in search tree order
+/// rather than in key order.
+///
+/// Entries are addressed by their index in storage order: see \ref keys and
+/// \ref values.
+///
+/// \tparam KeyT The type of each key.
+/// \tparam ValueT The type of each value.
+/// \tparam LayoutV The order in which keys are stored.
+/// \tparam CompareT Strict weak ordering of keys.
+template<typename KeyT,
+         typename ValueT,
+         FlatMapLayout LayoutV = FlatMapLayout::Sorted,
+         typename CompareT = std::less<KeyT>>
+class FlatMap
+{
+public:
+    /// \typedef key_type
+    ///
+    /// The type of each key.
+    using key_type = KeyT;
+
+    /// \typedef mapped_type
+    ///
+    /// The type of each value.
+    using mapped_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// The order in which keys are stored.
+    static constexpr FlatMapLayout layout = LayoutV;
+
+    /// Returned by \ref find_index for missing keys.
+    static constexpr size_type npos = size_type(-1);
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Constructs an empty map.
+    FlatMap() = default;
+
+    /// Constructs a map from a range of key-value pairs, in any order.  Of
+    /// pairs with equivalent keys, the first is kept.
+    ///
+    /// \param first The first pair in the range.
+    /// \param last The position after the last pair in the range.
+    /// \param compare The key ordering.
+    template<std::input_iterator IteratorT>
+    FlatMap(IteratorT first,
+            IteratorT last,
+            const CompareT& compare = CompareT())
+      : m_compare(compare)
+    {
+        _Build(first, last);
+    }
+
+    /// Constructs a map from an initializer list of key-value pairs.
+    ///
+    /// \param pairs The key-value pairs.
+    /// \param compare The key ordering.
+    FlatMap(std::initializer_list<std::pair<KeyT, ValueT>> pairs,
+            const CompareT& compare = CompareT())
+      : m_compare(compare)
+    {
+        _Build(pairs.begin(), pairs.end());
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Lookup
+    // -----------------------------------------------------------------------
+
+    /// Find the storage index of \p key.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return The index, or \ref npos if the key is missing.
+    size_type find_index(const KeyT& key) const
+    {
+        size_type index = _LowerBound(key);
+        if (index == npos || m_compare(key, m_keys[index])) {
+            return npos;
+        }
+        return index;
+    }
+
+    /// Find the value of \p key, in a read-only fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return The value, or \p nullptr if the key is missing.
+    const ValueT* find(const KeyT& key) const
+    {
+        size_type index = find_index(key);
+        return index == npos ? nullptr : &m_values[index];
+    }
+
+    /// Find the value of \p key, in a mutable fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return The value, or \p nullptr if the key is missing.
+    ValueT* find(const KeyT& key)
+    {
+        size_type index = find_index(key);
+        return index == npos ? nullptr : &m_values[index];
+    }
+
+    /// Check if \p key is present.
+    ///
+    /// \param key The key to search for.
+    bool contains(const KeyT& key) const { return find_index(key) != npos; }
+
+    /// Get the value of \p key, in a read-only fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return The value.
+    const ValueT& at(const KeyT& key) const
+    {
+        const ValueT* value = find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("Key is not present.");
+        }
+
+        return *value;
+    }
+
+    /// Get the keys, in storage order.
+    const Vector<KeyT>& keys() const { return m_keys; }
+
+    /// Get the values, in storage order.
+    const Vector<ValueT>& values() const { return m_values; }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if there are no entries.
+    bool empty() const { return m_keys.empty(); }
+
+    /// Get the number of entries.
+    size_type size() const { return m_keys.size(); }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Insert \p value for \p key, if the key is missing.  Only available
+    /// with the sorted layout.
+    ///
+    /// \param key The key.
+    /// \param value The value.
+    ///
+    /// \return Whether the entry was inserted.
+    bool insert(const KeyT& key, const ValueT& value)
+        requires(LayoutV == FlatMapLayout::Sorted)
+    {
+        size_type index = _LowerBound(key);
+        if (index == npos) {
+            index = m_keys.size();
+        } else if (!m_compare(key, m_keys[index])) {
+            return false;
+        }
+
+        m_keys.insert(m_keys.begin() + index, key);
+        m_values.insert(m_values.begin() + index, value);
+        return true;
+    }
+
+    /// Erase the entry of \p key.  Only available with the sorted layout.
+    ///
+    /// \param key The key.
+    ///
+    /// \return Whether an entry was erased.
+    bool erase(const KeyT& key) requires(LayoutV == FlatMapLayout::Sorted)
+    {
+        size_type index = find_index(key);
+        if (index == npos) {
+            return false;
+        }
+
+        m_keys.erase(m_keys.begin() + index);
+        m_values.erase(m_values.begin() + index);
+        return true;
+    }
+
+    /// Remove all entries.
+    void clear()
+    {
+        m_keys.clear();
+        m_values.clear();
+    }
+
+private:
+    // Number of keys per cache line.  The descendants of an Eytzinger node
+    // which are log2 of this many levels down are adjacent, and fit in about
+    // one cache line.
+    static constexpr size_type s_keysPerLine =
+        std::max<size_type>(1, 64 / sizeof(KeyT));
+
+    // Build from a range of unsorted pairs.
+    template<typename IteratorT>
+    void _Build(IteratorT first, IteratorT last)
+    {
+        Vector<std::pair<KeyT, ValueT>> pairs(first, last);
+        std::stable_sort(pairs.begin(), pairs.end(), [&](auto& l, auto& r) {
+            return m_compare(l.first, r.first);
+        });
+        auto unique =
+            std::unique(pairs.begin(), pairs.end(), [&](auto& l, auto& r) {
+                return !m_compare(l.first, r.first);
+            });
+        size_type count = unique - pairs.begin();
+
+        m_keys.reserve(count);
+        m_values.reserve(count);
+        if constexpr (LayoutV == FlatMapLayout::Sorted) {
+            for (size_type index = 0; index < count; ++index) {
+                m_keys.push_back(std::move(pairs[index].first));
+                m_values.push_back(std::move(pairs[index].second));
+            }
+        } else {
+            // Fill the tree in order, so that it visits the sorted pairs in
+            // ascending order.
+            m_keys.resize(count);
+            m_values.resize(count);
+            size_type sortedIndex = 0;
+            _FillEytzinger(pairs, sortedIndex, 1);
+        }
+    }
+
+    // Fill the subtree rooted at 1-based node \p node, from \p pairs
+    // starting at \p sortedIndex.
+    void _FillEytzinger(Vector<std::pair<KeyT, ValueT>>& pairs,
+                        size_type& sortedIndex,
+                        size_type node)
+    {
+        if (node > m_keys.size()) {
+            return;
+        }
+
+        _FillEytzinger(pairs, sortedIndex, 2 * node);
+        m_keys[node - 1] = std::move(pairs[sortedIndex].first);
+        m_values[node - 1] = std::move(pairs[sortedIndex].second);
+        sortedIndex++;
+        _FillEytzinger(pairs, sortedIndex, 2 * node + 1);
+    }
+
+    // Find the storage index of the first key not ordered before \p key.
+    //
+    // \return The index, or \ref npos if every key is ordered before.
+    size_type _LowerBound(const KeyT& key) const
+    {
+        size_type count = m_keys.size();
+        const KeyT* keys = m_keys.data();
+
+        if constexpr (LayoutV == FlatMapLayout::Sorted) {
+            if (count == 0) {
+                return npos;
+            }
+
+            // Halve the range without branching on the comparison.
+            const KeyT* base = keys;
+            while (count > 1) {
+                size_type half = count / 2;
+                base = m_compare(base[half], key) ? base + half : base;
+                count -= half;
+            }
+            size_type index = (base - keys) + m_compare(*base, key);
+            return index == m_keys.size() ? npos : index;
+        } else {
+            // Descend the tree, going right whenever the node is ordered
+            // before the key, while prefetching the descendants of the node
+            // a cache line's worth of levels down.
+            size_type node = 1;
+            while (node <= count) {
+                __builtin_prefetch(keys + s_keysPerLine * node - 1);
+                node = 2 * node + m_compare(keys[node - 1], key);
+            }
+
+            // Undo the right turns since the last left turn, whose node is
+            // the lower bound.
+            node >>= std::countr_one(node) + 1;
+            return node == 0 ? npos : node - 1;
+        }
+    }
+
+    [[no_unique_address]] CompareT m_compare;
+    Vector<KeyT> m_keys;
+    Vector<ValueT> m_values;
+};
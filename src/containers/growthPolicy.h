@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Growth policies compute the capacity a container should grow to, from its
+// current \p capacity, when it must hold at least \p required elements of
+// \p elementSize bytes each.  They are supplied as the \p GrowthPolicyT
+// parameter of \ref Vector.
+
+/// \class GeometricGrowth
+///
+/// Multiplies the capacity by \p NumeratorV / \p DenominatorV (by at least one
+/// element) until it fits the requirement, starting from a capacity of 1.
+///
+/// \tparam NumeratorV Numerator of the growth factor.
+/// \tparam DenominatorV Denominator of the growth factor.
+template<std::size_t NumeratorV, std::size_t DenominatorV = 1>
+struct GeometricGrowth
+{
+    static_assert(NumeratorV > DenominatorV, "Growth factor must exceed 1.");
+
+    static std::size_t NextCapacity(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t /* elementSize */)
+    {
+        std::size_t nextCapacity = std::max<std::size_t>(capacity, 1);
+        while (required > nextCapacity) {
+            nextCapacity = std::max(nextCapacity * NumeratorV / DenominatorV,
+                                    nextCapacity + 1);
+        }
+
+        return nextCapacity;
+    }
+};
+
+/// \typedef DoublingGrowth
+///
+/// Grow by a factor of 2.  Amortizes copies the most, at the cost of up to
+/// 50% un-used capacity.  This is the default policy of \ref Vector.
+using DoublingGrowth = GeometricGrowth<2>;
+
+/// \typedef OneAndHalfGrowth
+///
+/// Grow by a factor of 1.5, wasting at most a third of the capacity and
+/// allowing freed blocks to be re-used by later growth.
+using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+/// \class FixedIncrementGrowth
+///
+/// Grow by multiples of \p IncrementV elements.  Wastes less than one
+/// increment, but makes repeated appends quadratic unless growth happens in
+/// place (see \ref MmapAllocator).
+///
+/// \tparam IncrementV The number of elements to grow by.
+template<std::size_t IncrementV>
+struct FixedIncrementGrowth
+{
+    static_assert(IncrementV > 0, "Increment must be non-zero.");
+
+    static std::size_t NextCapacity(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t /* elementSize */)
+    {
+        std::size_t increments =
+            (required - capacity + IncrementV - 1) / IncrementV;
+        return capacity + increments * IncrementV;
+    }
+};
+
+/// \class PageRoundedGrowth
+///
+/// Applies \p BaseGrowthT, then rounds the size of the buffer up to a multiple
+/// of \p PageSizeV bytes, so that page-granular allocators (such as
+/// \ref MmapAllocator) leave no tail un-used.
+///
+/// \tparam BaseGrowthT The growth policy to round.
+/// \tparam PageSizeV The page size in bytes.
+template<typename BaseGrowthT = DoublingGrowth, std::size_t PageSizeV = 4096>
+struct PageRoundedGrowth
+{
+    static std::size_t NextCapacity(std::size_t capacity,
+                                    std::size_t required,
+                                    std::size_t elementSize)
+    {
+        std::size_t nextCapacity =
+            BaseGrowthT::NextCapacity(capacity, required, elementSize);
+        std::size_t bytes = (nextCapacity * elementSize + PageSizeV - 1) /
+                            PageSizeV * PageSizeV;
+        return bytes / elementSize;
+    }
+};
@@ -0,0 +1,616 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "allocator.h"
+#include "vector.h"
+
+/// \class HashMap
+///
+/// An open-addressing hash map which stores its entries in place, in one
+/// array of slots, in the style of SwissTable.
+///
+/// Each slot has a control byte, which is either empty or holds 7 bits of
+/// the hash of the key in the slot.  A lookup compares 16 control bytes at a
+/// time against the hash bits of the key (with SSE2 where available), and
+/// only compares keys of the slots which match, so that most probes never
+/// touch the slots.
+///
+/// Keys are placed by linear probing, and erasure shifts the following
+/// entries of the probe run back into the hole rather than leaving a
+/// tombstone, so that lookups never slow down from churn.  Erasure
+/// re-hashes the shifted keys.
+///
+/// Insertion may move every entry, invalidating iterators and references.
+///
+/// \tparam KeyT The type of each key.
+/// \tparam ValueT The type of each value.
+/// \tparam HashT Hashes keys.
+/// \tparam KeyEqualT Compares keys for equality.
+/// \tparam AllocatorT Allocates the slots.
+template<typename KeyT,
+         typename ValueT,
+         typename HashT = std::hash<KeyT>,
+         typename KeyEqualT = std::equal_to<KeyT>,
+         typename AllocatorT = MallocAllocator<std::pair<KeyT, ValueT>>>
+class HashMap
+{
+public:
+    /// \typedef value_type
+    ///
+    /// The type of each entry.  Its key must not be modified.
+    using value_type = std::pair<KeyT, ValueT>;
+
+    /// \typedef key_type
+    ///
+    /// The type of each key.
+    using key_type = KeyT;
+
+    /// \typedef mapped_type
+    ///
+    /// The type of each value.
+    using mapped_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+private:
+    // Forward iterator over the occupied slots, in a mutable or read-only
+    // fashion.
+    template<typename MapT, typename EntryT>
+    class _Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<EntryT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = EntryT*;
+        using reference = EntryT&;
+
+        _Iterator() = default;
+
+        _Iterator(MapT* map, std::size_t slot)
+          : m_map(map)
+          , m_slot(slot)
+        {
+            _SkipEmpty();
+        }
+
+        /// Converting constructor, from a mutable to a read-only iterator.
+        template<typename OtherMapT, typename OtherEntryT>
+        _Iterator(const _Iterator<OtherMapT, OtherEntryT>& other)
+            requires(std::is_const_v<EntryT> &&
+                     !std::is_const_v<OtherEntryT>)
+          : m_map(other.m_map)
+          , m_slot(other.m_slot)
+        {}
+
+        reference operator*() const { return m_map->m_slots[m_slot]; }
+
+        pointer operator->() const { return &m_map->m_slots[m_slot]; }
+
+        _Iterator& operator++()
+        {
+            ++m_slot;
+            _SkipEmpty();
+            return *this;
+        }
+
+        _Iterator operator++(int)
+        {
+            _Iterator copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        bool operator==(const _Iterator& other) const
+        {
+            return m_slot == other.m_slot;
+        }
+
+    private:
+        template<typename, typename>
+        friend class _Iterator;
+        friend class HashMap;
+
+        void _SkipEmpty()
+        {
+            while (m_slot < m_map->m_capacity &&
+                   m_map->m_control[m_slot] == s_empty) {
+                ++m_slot;
+            }
+        }
+
+        MapT* m_map = nullptr;
+        std::size_t m_slot = 0;
+    };
+
+public:
+    /// \typedef iterator
+    ///
+    /// Iterator over the entries, in a mutable fashion.
+    using iterator = _Iterator<HashMap, value_type>;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the entries, in a read-only fashion.
+    using const_iterator = _Iterator<const HashMap, const value_type>;
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Constructs an empty map, without allocating.
+    HashMap() = default;
+
+    /// Constructs an empty map which can hold \p count entries without
+    /// re-hashing.
+    ///
+    /// \param count The number of entries.
+    explicit HashMap(size_type count) { reserve(count); }
+
+    /// Copy constructor.
+    ///
+    /// \param src The source map to copy the entries of.
+    HashMap(const HashMap& src)
+      : m_hash(src.m_hash)
+      , m_equal(src.m_equal)
+      , m_allocator(src.m_allocator)
+    {
+        reserve(src.m_size);
+        for (const value_type& entry : src) {
+            _InsertUnique(_Hash(entry.first), entry);
+        }
+    }
+
+    /// Move constructor.
+    ///
+    /// \param src The source map to take the slots of.
+    HashMap(HashMap&& src) noexcept { swap(src); }
+
+    /// Destroys the entries, and frees the slots.
+    ~HashMap()
+    {
+        clear();
+        _Free();
+    }
+
+    /// Copy assignment.
+    ///
+    /// \param src The source map to copy the entries of.
+    HashMap& operator=(const HashMap& src)
+    {
+        if (this != &src) {
+            HashMap copy(src);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment.
+    ///
+    /// \param src The source map to take the slots of.
+    HashMap& operator=(HashMap&& src) noexcept
+    {
+        if (this != &src) {
+            HashMap moved(std::move(src));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Lookup
+    // -----------------------------------------------------------------------
+
+    /// Find the entry of \p key, in a mutable fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return Iterator to the entry, or \ref end if the key is missing.
+    iterator find(const KeyT& key)
+    {
+        return iterator(this, _Find(_Hash(key), key));
+    }
+
+    /// Find the entry of \p key, in a read-only fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return Iterator to the entry, or \ref end if the key is missing.
+    const_iterator find(const KeyT& key) const
+    {
+        return const_iterator(this, _Find(_Hash(key), key));
+    }
+
+    /// Check if \p key is present.
+    ///
+    /// \param key The key to search for.
+    bool contains(const KeyT& key) const
+    {
+        return _Find(_Hash(key), key) != m_capacity;
+    }
+
+    /// Get the value of \p key, in a read-only fashion.
+    ///
+    /// \param key The key to search for.
+    ///
+    /// \return The value.
+    const ValueT& at(const KeyT& key) const
+    {
+        size_type slot = _Find(_Hash(key), key);
+        if (slot == m_capacity) {
+            throw std::out_of_range("Key is not present.");
+        }
+
+        return m_slots[slot].second;
+    }
+
+    /// Get the value of \p key, inserting a value-initialized one if the key
+    /// is missing.
+    ///
+    /// \param key The key.
+    ///
+    /// \return The value.
+    ValueT& operator[](const KeyT& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Iterators
+    // -----------------------------------------------------------------------
+
+    /// Get an iterator to the first entry, in a mutable fashion.
+    iterator begin() { return iterator(this, 0); }
+
+    /// Get an iterator past the last entry, in a mutable fashion.
+    iterator end() { return iterator(this, m_capacity); }
+
+    /// Get an iterator to the first entry, in a read-only fashion.
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    /// Get an iterator past the last entry, in a read-only fashion.
+    const_iterator end() const { return const_iterator(this, m_capacity); }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if there are no entries.
+    bool empty() const { return m_size == 0; }
+
+    /// Get the number of entries.
+    size_type size() const { return m_size; }
+
+    /// Get the number of slots.
+    size_type capacity() const { return m_capacity; }
+
+    /// Allocate enough slots to hold \p count entries without re-hashing.
+    ///
+    /// \param count The number of entries.
+    void reserve(size_type count)
+    {
+        if (count > _MaxLoad(m_capacity)) {
+            // Round up, so that count fits under the maximum load factor.
+            size_type capacity = std::bit_ceil(
+                std::max<size_type>(s_groupWidth, count + count / 7 + 1));
+            _Rehash(capacity);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Insert a value constructed from \p args for \p key, if the key is
+    /// missing.
+    ///
+    /// \param key The key.
+    /// \param args The value constructor arguments.
+    ///
+    /// \return Iterator to the entry of \p key, and whether it was inserted.
+    template<typename... ArgsT>
+    std::pair<iterator, bool> try_emplace(const KeyT& key, ArgsT&&... args)
+    {
+        std::size_t hash = _Hash(key);
+        size_type slot = _Find(hash, key);
+        if (slot != m_capacity) {
+            return { iterator(this, slot), false };
+        }
+
+        reserve(m_size + 1);
+        slot = _InsertUnique(hash,
+                             std::piecewise_construct,
+                             std::forward_as_tuple(key),
+                             std::forward_as_tuple(
+                                 std::forward<ArgsT>(args)...));
+        return { iterator(this, slot), true };
+    }
+
+    /// Insert \p entry, if its key is missing.
+    ///
+    /// \param entry The key and value.
+    ///
+    /// \return Iterator to the entry of the key, and whether it was inserted.
+    std::pair<iterator, bool> insert(const value_type& entry)
+    {
+        return try_emplace(entry.first, entry.second);
+    }
+
+    /// Insert \p entry by move, if its key is missing.
+    ///
+    /// \param entry The key and value.
+    ///
+    /// \return Iterator to the entry of the key, and whether it was inserted.
+    std::pair<iterator, bool> insert(value_type&& entry)
+    {
+        std::size_t hash = _Hash(entry.first);
+        size_type slot = _Find(hash, entry.first);
+        if (slot != m_capacity) {
+            return { iterator(this, slot), false };
+        }
+
+        reserve(m_size + 1);
+        slot = _InsertUnique(hash, std::move(entry));
+        return { iterator(this, slot), true };
+    }
+
+    /// Insert \p value for \p key, or assign it if the key is present.
+    ///
+    /// \param key The key.
+    /// \param value The value.
+    ///
+    /// \return Iterator to the entry of \p key, and whether it was inserted.
+    template<typename OtherValueT>
+    std::pair<iterator, bool> insert_or_assign(const KeyT& key,
+                                               OtherValueT&& value)
+    {
+        auto result = try_emplace(key, std::forward<OtherValueT>(value));
+        if (!result.second) {
+            result.first->second = std::forward<OtherValueT>(value);
+        }
+        return result;
+    }
+
+    /// Erase the entry of \p key.
+    ///
+    /// \param key The key.
+    ///
+    /// \return The number of erased entries.
+    size_type erase(const KeyT& key)
+    {
+        size_type slot = _Find(_Hash(key), key);
+        if (slot == m_capacity) {
+            return 0;
+        }
+
+        _EraseSlot(slot);
+        return 1;
+    }
+
+    /// Destroy all entries, keeping the slots allocated.
+    void clear()
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type slot = 0; slot < m_capacity; ++slot) {
+                if (m_control[slot] != s_empty) {
+                    std::destroy_at(m_slots + slot);
+                }
+            }
+        }
+
+        std::fill(m_control.begin(), m_control.end(), s_empty);
+        m_size = 0;
+    }
+
+    /// Swap the contents of this map with \p other.
+    ///
+    /// \param other The map to swap with.
+    void swap(HashMap& other) noexcept
+    {
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_equal, other.m_equal);
+        std::swap(m_allocator, other.m_allocator);
+        m_control.swap(other.m_control);
+        std::swap(m_slots, other.m_slots);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+    }
+
+private:
+    // Number of control bytes compared at once.
+    static constexpr size_type s_groupWidth = 16;
+
+    // Control byte of an empty slot.  Those of full slots are 7 hash bits.
+    static constexpr std::int8_t s_empty = -128;
+
+    // Largest number of entries held by \p capacity slots: 7/8 of them.
+    static constexpr size_type _MaxLoad(size_type capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    // Hash \p key, mixing the bits so that weak hashes (such as the identity
+    // hash of integers) spread over both the slot index and control bits.
+    std::size_t _Hash(const KeyT& key) const
+    {
+        std::uint64_t hash =
+            std::uint64_t(m_hash(key)) * 0x9E3779B97F4A7C15ull;
+        return hash ^ (hash >> 32);
+    }
+
+    // The control byte of a key with \p hash.
+    static std::int8_t _ControlBits(std::size_t hash) { return hash & 0x7F; }
+
+    // The slot at which a key with \p hash starts probing.
+    size_type _HomeSlot(std::size_t hash) const
+    {
+        return (hash >> 7) & (m_capacity - 1);
+    }
+
+    // Get a bit mask of the control bytes starting at \p slot which equal
+    // \p control, bit i standing for slot + i.
+    std::uint32_t _MatchGroup(size_type slot, std::int8_t control) const
+    {
+        const std::int8_t* group = m_control.data() + slot;
+#if defined(__SSE2__)
+        __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+        return _mm_movemask_epi8(
+            _mm_cmpeq_epi8(bytes, _mm_set1_epi8(control)));
+#else
+        std::uint32_t mask = 0;
+        for (size_type index = 0; index < s_groupWidth; ++index) {
+            mask |= std::uint32_t(group[index] == control) << index;
+        }
+        return mask;
+#endif
+    }
+
+    // Find the slot holding \p key, whose hash is \p hash.
+    //
+    // \return The slot, or the capacity if the key is missing.
+    size_type _Find(std::size_t hash, const KeyT& key) const
+    {
+        if (m_size == 0) {
+            return m_capacity;
+        }
+
+        std::int8_t control = _ControlBits(hash);
+        size_type mask = m_capacity - 1;
+        for (size_type slot = _HomeSlot(hash);;
+             slot = (slot + s_groupWidth) & mask) {
+            for (std::uint32_t match = _MatchGroup(slot, control); match != 0;
+                 match &= match - 1) {
+                size_type candidate = (slot + std::countr_zero(match)) & mask;
+                if (m_equal(m_slots[candidate].first, key)) {
+                    return candidate;
+                }
+            }
+
+            // The key would have been placed before the first empty slot.
+            if (_MatchGroup(slot, s_empty) != 0) {
+                return m_capacity;
+            }
+        }
+    }
+
+    // Construct an entry from \p args, for a key with \p hash which is
+    // known to be missing, into the first empty slot of its probe run.
+    // There must be room for it.
+    template<typename... ArgsT>
+    size_type _InsertUnique(std::size_t hash, ArgsT&&... args)
+    {
+        size_type mask = m_capacity - 1;
+        size_type slot = _HomeSlot(hash);
+        std::uint32_t empty;
+        while ((empty = _MatchGroup(slot, s_empty)) == 0) {
+            slot = (slot + s_groupWidth) & mask;
+        }
+        slot = (slot + std::countr_zero(empty)) & mask;
+
+        ::new (static_cast<void*>(m_slots + slot))
+            value_type(std::forward<ArgsT>(args)...);
+        _SetControl(slot, _ControlBits(hash));
+        m_size++;
+        return slot;
+    }
+
+    // Erase the entry of \p slot, then shift back later entries of the
+    // probe run which may occupy the hole without passing an empty slot.
+    void _EraseSlot(size_type slot)
+    {
+        size_type mask = m_capacity - 1;
+        std::destroy_at(m_slots + slot);
+
+        size_type hole = slot;
+        for (size_type next = (slot + 1) & mask; m_control[next] != s_empty;
+             next = (next + 1) & mask) {
+            // An entry may move back if its home slot is not after the hole.
+            size_type home = _HomeSlot(_Hash(m_slots[next].first));
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                ::new (static_cast<void*>(m_slots + hole))
+                    value_type(std::move(m_slots[next]));
+                std::destroy_at(m_slots + next);
+                _SetControl(hole, m_control[next]);
+                hole = next;
+            }
+        }
+
+        _SetControl(hole, s_empty);
+        m_size--;
+    }
+
+    // Set the control byte of \p slot, and its copy past the end which lets
+    // groups starting near the end wrap around.
+    void _SetControl(size_type slot, std::int8_t control)
+    {
+        m_control[slot] = control;
+        if (slot < s_groupWidth - 1) {
+            m_control[m_capacity + slot] = control;
+        }
+    }
+
+    // Move the entries into \p capacity new slots.
+    void _Rehash(size_type capacity)
+    {
+        HashMap rehashed;
+        rehashed.m_hash = m_hash;
+        rehashed.m_equal = m_equal;
+        rehashed.m_allocator = m_allocator;
+        rehashed.m_slots = rehashed.m_allocator.allocate(capacity);
+        rehashed.m_capacity = capacity;
+        rehashed.m_control.resize(capacity + s_groupWidth - 1, s_empty);
+
+        for (size_type slot = 0; slot < m_capacity; ++slot) {
+            if (m_control[slot] != s_empty) {
+                rehashed._InsertUnique(_Hash(m_slots[slot].first),
+                                       std::move(m_slots[slot]));
+            }
+        }
+
+        swap(rehashed);
+    }
+
+    void _Free()
+    {
+        if (m_slots != nullptr) {
+            m_allocator.deallocate(m_slots, m_capacity);
+            m_slots = nullptr;
+        }
+    }
+
+    [[no_unique_address]] HashT m_hash;
+    [[no_unique_address]] KeyEqualT m_equal;
+    [[no_unique_address]] AllocatorT m_allocator;
+
+    // One control byte per slot, followed by copies of the first group's
+    // worth minus one.
+    Vector<std::int8_t> m_control;
+
+    // Slots, constructed where the control byte is not empty.
+    value_type* m_slots = nullptr;
+
+    // Number of slots, zero or a power of two.
+    size_type m_capacity = 0;
+
+    // Number of entries.
+    size_type m_size = 0;
+};
@@ -0,0 +1,432 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>    // open.
+#include <sys/mman.h> // mmap, mremap, munmap, madvise, msync.
+#include <sys/stat.h> // fstat.
+#include <unistd.h>   // ftruncate, close.
+
+#include "growthPolicy.h"
+
+/// \enum MapMode
+///
+/// How \ref MappedVector maps its file, or \ref SharedVector its segment.
+enum class MapMode
+{
+    /// Map the file read-only.  The file must exist.
+    ReadOnly,
+
+    /// Map the file with \p MAP_SHARED, so that writes land in the file.
+    /// The file is created if it does not exist.
+    ReadWrite,
+};
+
+/// \class MappedVector
+///
+/// A vector whose elements are the raw contents of a binary file, mapped
+/// into memory rather than read: opening a file of any size is immediate,
+/// and pages are loaded by the kernel on first access.
+///
+/// In \ref MapMode::ReadOnly, elements are only accessible as \p const, so
+/// that writes into the read-only mapping fail to compile rather than fault.
+/// In \ref MapMode::ReadWrite, the vector can grow.  Capacity is reserved by
+/// extending the file with \p ftruncate and re-mapping it with \p mremap, and
+/// the file is truncated back to the size of the vector when it is
+/// destroyed.
+///
+/// \tparam ValueT The type of each element, which must be trivially
+/// copyable.
+/// \tparam ModeT How to map the file.
+/// \tparam GrowthPolicyT Computes the capacity to grow to.
+template<typename ValueT,
+         MapMode ModeT = MapMode::ReadOnly,
+         typename GrowthPolicyT = PageRoundedGrowth<DoublingGrowth>>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable<ValueT>::value,
+                  "Mapped elements must be trivially copyable.");
+
+    // Growing and modifying require a writable mapping.
+    static constexpr bool s_writable = ModeT == MapMode::ReadWrite;
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef reference
+    ///
+    /// Reference to a mapped element, which is \p const in
+    /// \ref MapMode::ReadOnly.
+    using reference =
+        std::conditional_t<s_writable, value_type&, const value_type&>;
+
+    /// \typedef pointer
+    ///
+    /// Pointer to a mapped element, which is \p const in
+    /// \ref MapMode::ReadOnly.
+    using pointer =
+        std::conditional_t<s_writable, value_type*, const value_type*>;
+
+    /// \typedef iterator
+    ///
+    /// Iterator over the mapped elements, which is read-only in
+    /// \ref MapMode::ReadOnly.
+    using iterator = pointer;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the mapped elements, in a read-only fashion.
+    using const_iterator = const value_type*;
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Map the file at \p path.  Its size must be a multiple of the size of
+    /// \p ValueT.
+    ///
+    /// \param path The path to the file.
+    ///
+    /// \throws std::system_error If the file cannot be opened or mapped.
+    explicit MappedVector(const std::string& path)
+    {
+        m_fd = s_writable ? open(path.c_str(), O_RDWR | O_CREAT, 0644)
+                          : open(path.c_str(), O_RDONLY);
+        if (m_fd < 0) {
+            _ThrowSystemError("Failed to open " + path);
+        }
+
+        struct stat fileStat;
+        if (fstat(m_fd, &fileStat) < 0) {
+            close(m_fd);
+            _ThrowSystemError("Failed to stat " + path);
+        }
+
+        if (fileStat.st_size % sizeof(value_type) != 0) {
+            close(m_fd);
+            throw std::runtime_error(
+                path + " does not contain a whole number of elements.");
+        }
+
+        m_size = fileStat.st_size / sizeof(value_type);
+        m_capacity = m_size;
+        if (m_capacity != 0) {
+            try {
+                m_data = _Map(m_capacity);
+            } catch (...) {
+                close(m_fd);
+                throw;
+            }
+        }
+    }
+
+    /// Un-maps the file, truncating it to the size of the vector if it was
+    /// mapped read-write.
+    ~MappedVector() { _Close(); }
+
+    /// Move constructor.
+    ///
+    /// \param src The source vector to move the mapping from.
+    MappedVector(MappedVector&& src) noexcept
+      : m_fd(std::exchange(src.m_fd, -1))
+      , m_advice(src.m_advice)
+      , m_size(std::exchange(src.m_size, 0))
+      , m_capacity(std::exchange(src.m_capacity, 0))
+      , m_data(std::exchange(src.m_data, nullptr))
+    {}
+
+    /// Move assignment operator.
+    ///
+    /// \param src The source vector to move the mapping from.
+    MappedVector& operator=(MappedVector&& src) noexcept
+    {
+        if (this != &src) {
+            _Close();
+            m_fd = std::exchange(src.m_fd, -1);
+            m_advice = src.m_advice;
+            m_size = std::exchange(src.m_size, 0);
+            m_capacity = std::exchange(src.m_capacity, 0);
+            m_data = std::exchange(src.m_data, nullptr);
+        }
+        return *this;
+    }
+
+    // Mappings are unique.
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access a read-only element.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    /// Access an element, which is mutable in \ref MapMode::ReadWrite.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    reference operator[](size_type index) { return m_data[index]; }
+
+    /// Access a read-only element with bounds checking.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& at(size_type index) const
+    {
+        if (index >= m_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return m_data[index];
+    }
+
+    /// Access the mapped elements, in a read-only fashion.
+    ///
+    /// \return Pointer to the first element, or \p nullptr if nothing is
+    /// mapped.
+    const value_type* data() const { return m_data; }
+
+    /// Access the mapped elements, which are mutable in
+    /// \ref MapMode::ReadWrite.
+    ///
+    /// \return Pointer to the first element, or \p nullptr if nothing is
+    /// mapped.
+    pointer data() { return m_data; }
+
+    /// Access the first element, in a read-only fashion.
+    const value_type& front() const { return m_data[0]; }
+
+    /// Access the last element, in a read-only fashion.
+    const value_type& back() const { return m_data[m_size - 1]; }
+
+    // -----------------------------------------------------------------------
+    /// \name Iterators
+    // -----------------------------------------------------------------------
+
+    /// Get an iterator to the first element, in a read-only fashion.
+    const_iterator begin() const { return m_data; }
+
+    /// Get an iterator past the last element, in a read-only fashion.
+    const_iterator end() const { return m_data + m_size; }
+
+    /// Get an iterator to the first element, which is mutable in
+    /// \ref MapMode::ReadWrite.
+    iterator begin() { return m_data; }
+
+    /// Get an iterator past the last element, which is mutable in
+    /// \ref MapMode::ReadWrite.
+    iterator end() { return m_data + m_size; }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if the vector has no elements.
+    bool empty() const { return m_size == 0; }
+
+    /// Get the number of elements.
+    size_type size() const { return m_size; }
+
+    /// Get the number of elements which fit in the file without extending
+    /// it.
+    size_type capacity() const { return m_capacity; }
+
+    /// Get the mode the file was mapped with.
+    static constexpr MapMode mode() { return ModeT; }
+
+    /// Extend the file to hold at least \p count elements.  Requires
+    /// \ref MapMode::ReadWrite.
+    ///
+    /// \param count The number of elements.
+    void reserve(size_type count)
+    {
+        static_assert(s_writable, "Cannot grow a read-only MappedVector.");
+        if (count > m_capacity) {
+            _Grow(count);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Append an element.  Requires \ref MapMode::ReadWrite.
+    ///
+    /// \param value The element value.
+    void push_back(const value_type& value)
+    {
+        static_assert(s_writable, "Cannot modify a read-only MappedVector.");
+        if (m_size + 1 > m_capacity) {
+            _Grow(GrowthPolicyT::NextCapacity(
+                m_capacity, m_size + 1, sizeof(value_type)));
+        }
+
+        m_data[m_size] = value;
+        m_size++;
+    }
+
+    /// Resize to contain \p count elements, appending value-initialized
+    /// elements when increasing in size.  Growing requires
+    /// \ref MapMode::ReadWrite.
+    ///
+    /// \param count The number of elements.
+    void resize(size_type count)
+    {
+        static_assert(s_writable, "Cannot modify a read-only MappedVector.");
+        if (count > m_capacity) {
+            _Grow(count);
+        }
+
+        if (count > m_size) {
+            std::fill(m_data + m_size, m_data + count, value_type());
+        }
+        m_size = count;
+    }
+
+    /// Remove all elements.  The file is truncated on destruction.
+    void clear() { m_size = 0; }
+
+    // -----------------------------------------------------------------------
+    /// \name Mapping
+    // -----------------------------------------------------------------------
+
+    /// Advise the kernel of the expected access pattern of the elements,
+    /// such as \p MADV_SEQUENTIAL, \p MADV_RANDOM or \p MADV_WILLNEED.  The
+    /// advice is re-applied whenever the file is re-mapped.
+    ///
+    /// \param advice The \p madvise advice.
+    void advise(int advice)
+    {
+        m_advice = advice;
+        _Advise();
+    }
+
+    /// Synchronously flush modified elements to the file.
+    void sync()
+    {
+        if (m_data != nullptr &&
+            msync(m_data, _MapBytes(m_capacity), MS_SYNC) < 0) {
+            _ThrowSystemError("Failed to msync");
+        }
+    }
+
+private:
+    [[noreturn]] static void _ThrowSystemError(const std::string& message)
+    {
+        throw std::system_error(errno, std::generic_category(), message);
+    }
+
+    // Number of bytes of mapping for \p count elements.
+    static size_type _MapBytes(size_type count)
+    {
+        return sizeof(value_type) * count;
+    }
+
+    // Map the first \p count elements of the file.
+    value_type* _Map(size_type count)
+    {
+        int protection = s_writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* ptr =
+            mmap(nullptr, _MapBytes(count), protection, MAP_SHARED, m_fd, 0);
+        if (ptr == MAP_FAILED) {
+            _ThrowSystemError("Failed to mmap");
+        }
+
+        return static_cast<value_type*>(ptr);
+    }
+
+    // Extend the file to hold \p count elements, and re-map it.
+    void _Grow(size_type count)
+    {
+        if (ftruncate(m_fd, _MapBytes(count)) < 0) {
+            _ThrowSystemError("Failed to ftruncate");
+        }
+
+        if (m_data == nullptr) {
+            m_data = _Map(count);
+        } else {
+            void* ptr = mremap(m_data,
+                               _MapBytes(m_capacity),
+                               _MapBytes(count),
+                               MREMAP_MAYMOVE);
+            if (ptr == MAP_FAILED) {
+                _ThrowSystemError("Failed to mremap");
+            }
+            m_data = static_cast<value_type*>(ptr);
+        }
+
+        m_capacity = count;
+        _Advise();
+    }
+
+    // Apply the current advice to the whole mapping.
+    void _Advise()
+    {
+        if (m_data != nullptr && m_advice != MADV_NORMAL &&
+            madvise(m_data, _MapBytes(m_capacity), m_advice) < 0) {
+            _ThrowSystemError("Failed to madvise");
+        }
+    }
+
+    // Un-map and close the file, truncating it to the current size.
+    void _Close()
+    {
+        if (m_data != nullptr) {
+            munmap(m_data, _MapBytes(m_capacity));
+            m_data = nullptr;
+        }
+
+        if (m_fd >= 0) {
+            if (s_writable && m_size != m_capacity) {
+                // Errors cannot be reported from a destructor: the file is
+                // left at its capacity instead.
+                (void)ftruncate(m_fd, _MapBytes(m_size));
+            }
+            close(m_fd);
+            m_fd = -1;
+        }
+
+        m_size = 0;
+        m_capacity = 0;
+    }
+
+    // File descriptor of the mapped file.
+    int m_fd = -1;
+
+    // The madvise advice applied to the mapping.
+    int m_advice = MADV_NORMAL;
+
+    // Number of elements in use.
+    size_type m_size = 0;
+
+    // Number of elements in the file (and mapping).
+    size_type m_capacity = 0;
+
+    // Pointer to the mapping.
+    value_type* m_data = nullptr;
+};
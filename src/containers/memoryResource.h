@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+
+/// \class MonotonicArena
+///
+/// A bump-pointer memory resource.
+///
+/// Allocations are carved sequentially out of chunks requested from an
+/// upstream resource, and individual de-allocations are no-ops.  All memory
+/// is returned to the upstream resource at once, via \ref release or when the
+/// arena is destroyed.
+///
+/// The arena is not thread-safe: give each task or thread its own instance.
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    /// Constructs an arena which requests chunks from \p upstream.
+    ///
+    /// \param initialChunkSize Size in bytes of the first chunk.  Subsequent
+    /// chunks double in size.
+    /// \param upstream The resource to obtain chunks from.
+    explicit MonotonicArena(
+        size_t initialChunkSize = 4096,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : m_nextChunkSize(std::max(initialChunkSize, sizeof(_ChunkHeader)))
+      , m_initialChunkSize(m_nextChunkSize)
+      , m_upstream(upstream)
+    {}
+
+    /// Constructs an arena which serves allocations out of \p buffer first,
+    /// before falling back to chunks requested from \p upstream.
+    ///
+    /// \param buffer Caller-owned storage, which must outlive the arena.
+    /// \param bufferSize Size of \p buffer in bytes.
+    /// \param upstream The resource to obtain chunks from.
+    MonotonicArena(
+        void* buffer,
+        size_t bufferSize,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : m_current(static_cast<std::byte*>(buffer))
+      , m_end(static_cast<std::byte*>(buffer) + bufferSize)
+      , m_nextChunkSize(std::max(bufferSize * 2, sizeof(_ChunkHeader)))
+      , m_initialChunkSize(m_nextChunkSize)
+      , m_buffer(m_current)
+      , m_bufferEnd(m_end)
+      , m_upstream(upstream)
+    {}
+
+    /// Releases all chunks back to the upstream resource.
+    ~MonotonicArena() override { release(); }
+
+    // Cannot be copied.
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /// Return every chunk to the upstream resource, invalidating all
+    /// allocations made from this arena.  Subsequent allocations are served
+    /// from the initial buffer again, if one was supplied.
+    void release()
+    {
+        while (m_chunks != nullptr) {
+            _ChunkHeader* next = m_chunks->next;
+            m_upstream->deallocate(
+                m_chunks, m_chunks->size, alignof(std::max_align_t));
+            m_chunks = next;
+        }
+
+        m_current = m_buffer;
+        m_end = m_bufferEnd;
+        m_nextChunkSize = m_initialChunkSize;
+    }
+
+    /// Get the upstream resource.
+    std::pmr::memory_resource* upstream_resource() const { return m_upstream; }
+
+private:
+    // Linked list node stored at the start of each upstream chunk.
+    struct _ChunkHeader
+    {
+        _ChunkHeader* next = nullptr;
+        size_t size = 0;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        // Try to bump-allocate from the current chunk.
+        void* ptr = _BumpAllocate(bytes, alignment);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+
+        // Otherwise request a new chunk large enough for this allocation.
+        size_t chunkSize = m_nextChunkSize;
+        while (chunkSize < sizeof(_ChunkHeader) + bytes + alignment) {
+            chunkSize *= 2;
+        }
+        m_nextChunkSize = chunkSize * 2;
+
+        void* chunk =
+            m_upstream->allocate(chunkSize, alignof(std::max_align_t));
+        _ChunkHeader* header = new (chunk) _ChunkHeader{ m_chunks, chunkSize };
+        m_chunks = header;
+        m_current = reinterpret_cast<std::byte*>(header + 1);
+        m_end = static_cast<std::byte*>(chunk) + chunkSize;
+
+        return _BumpAllocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* /* ptr */,
+                       size_t /* bytes */,
+                       size_t /* alignment */) override
+    {
+        // Memory is only reclaimed by release().
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    // Carve \p bytes from the current chunk, or return nullptr if it does not
+    // have enough space left.
+    void* _BumpAllocate(size_t bytes, size_t alignment)
+    {
+        if (m_current == nullptr) {
+            return nullptr;
+        }
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(m_current);
+        uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+        std::byte* ptr = m_current + (aligned - address);
+        if (ptr + bytes > m_end) {
+            return nullptr;
+        }
+
+        m_current = ptr + bytes;
+        return ptr;
+    }
+
+    // Next free byte, and the end of the current chunk.
+    std::byte* m_current = nullptr;
+    std::byte* m_end = nullptr;
+
+    // Size of the next chunk to request from upstream, and of the first.
+    size_t m_nextChunkSize = 0;
+    size_t m_initialChunkSize = 0;
+
+    // Caller-supplied initial buffer, if any, re-used after release().
+    std::byte* m_buffer = nullptr;
+    std::byte* m_bufferEnd = nullptr;
+
+    // Singly linked list of upstream chunks, most recent first.
+    _ChunkHeader* m_chunks = nullptr;
+
+    std::pmr::memory_resource* m_upstream = nullptr;
+};
+
+/// \class PoolResource
+///
+/// A memory resource serving fixed-size blocks from a free list.
+///
+/// Requests which fit in a block are popped from the free list (refilled in
+/// batches of \p blocksPerChunk from the upstream resource), and freed blocks
+/// are pushed back for re-use.  Larger or over-aligned requests are forwarded
+/// to the upstream resource.  All chunks are released when the pool is
+/// destroyed.
+///
+/// The pool is not thread-safe: give each task or thread its own instance.
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    /// Constructs a pool of \p blockSize byte blocks.
+    ///
+    /// \param blockSize Size in bytes of each block.
+    /// \param blocksPerChunk Number of blocks requested from upstream at once.
+    /// \param upstream The resource to obtain chunks from.
+    explicit PoolResource(
+        size_t blockSize,
+        size_t blocksPerChunk = 64,
+        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+      : m_blockSize(_RoundUp(std::max(blockSize, sizeof(_FreeBlock)),
+                             alignof(std::max_align_t)))
+      , m_blocksPerChunk(std::max<size_t>(blocksPerChunk, 1))
+      , m_upstream(upstream)
+    {}
+
+    /// Releases all chunks back to the upstream resource.
+    ~PoolResource() override { release(); }
+
+    // Cannot be copied.
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    /// Return every chunk to the upstream resource, invalidating all blocks
+    /// allocated from this pool.
+    void release()
+    {
+        while (m_chunks != nullptr) {
+            _FreeBlock* next = m_chunks->next;
+            m_upstream->deallocate(
+                m_chunks, _ChunkSize(), alignof(std::max_align_t));
+            m_chunks = next;
+        }
+
+        m_freeList = nullptr;
+    }
+
+    /// Get the size in bytes of each block.
+    size_t block_size() const { return m_blockSize; }
+
+    /// Get the upstream resource.
+    std::pmr::memory_resource* upstream_resource() const { return m_upstream; }
+
+private:
+    // Intrusive free list node stored in each unused block.
+    struct _FreeBlock
+    {
+        _FreeBlock* next = nullptr;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (!_FitsBlock(bytes, alignment)) {
+            return m_upstream->allocate(bytes, alignment);
+        }
+
+        if (m_freeList == nullptr) {
+            _Refill();
+        }
+
+        _FreeBlock* block = m_freeList;
+        m_freeList = block->next;
+        return block;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        if (!_FitsBlock(bytes, alignment)) {
+            m_upstream->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        m_freeList = new (ptr) _FreeBlock{ m_freeList };
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    bool _FitsBlock(size_t bytes, size_t alignment) const
+    {
+        return bytes <= m_blockSize && alignment <= alignof(std::max_align_t);
+    }
+
+    // Size of an upstream chunk: one block reserved for the chunk list link,
+    // followed by the pooled blocks.
+    size_t _ChunkSize() const { return m_blockSize * (m_blocksPerChunk + 1); }
+
+    // Request a new chunk from upstream and thread its blocks onto the free
+    // list.
+    void _Refill()
+    {
+        std::byte* chunk = static_cast<std::byte*>(
+            m_upstream->allocate(_ChunkSize(), alignof(std::max_align_t)));
+        m_chunks = new (chunk) _FreeBlock{ m_chunks };
+
+        for (size_t index = m_blocksPerChunk; index > 0; --index) {
+            m_freeList =
+                new (chunk + m_blockSize * index) _FreeBlock{ m_freeList };
+        }
+    }
+
+    static size_t _RoundUp(size_t value, size_t multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    size_t m_blockSize = 0;
+    size_t m_blocksPerChunk = 0;
+
+    // Blocks available for allocation.
+    _FreeBlock* m_freeList = nullptr;
+
+    // Singly linked list of upstream chunks, most recent first.
+    _FreeBlock* m_chunks = nullptr;
+
+    std::pmr::memory_resource* m_upstream = nullptr;
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <sys/mman.h> // mmap, mremap, munmap.
+#include <unistd.h>   // sysconf.
+
+#include "allocator.h"
+#include "growthPolicy.h"
+#include "vector.h"
+
+/// \class MmapAllocator
+///
+/// Allocator which maps anonymous, page-granular memory directly from the
+/// kernel, for very large buffers.
+///
+/// \ref reallocate is implemented with \p mremap, which re-maps the existing
+/// physical pages at a (possibly) new virtual address: growing a trivially
+/// relocatable \ref Vector never copies its contents, regardless of size.
+/// Un-touched capacity costs address space only, as pages are not backed by
+/// memory until first written.
+///
+/// \tparam ValueT The type of each element.
+template<typename ValueT>
+class MmapAllocator
+{
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// Mappings start on a page boundary, which is at least 4096 bytes.
+    static constexpr std::size_t alignment = 4096;
+
+    /// \typedef is_always_equal
+    ///
+    /// Any instance can unmap memory mapped by another.
+    using is_always_equal = std::true_type;
+
+    /// \typedef propagate_on_container_move_assignment
+    ///
+    /// Containers may adopt each others' storage on move assignment.
+    using propagate_on_container_move_assignment = std::true_type;
+
+    /// Default constructor.
+    MmapAllocator() = default;
+
+    /// Converting constructor, from an allocator of another value type.
+    template<typename OtherT>
+    MmapAllocator(const MmapAllocator<OtherT>&) noexcept
+    {}
+
+    /// Map storage for \p count elements.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return Pointer to the zero-filled storage.
+    value_type* allocate(std::size_t count)
+    {
+        return allocate_at_least(count).ptr;
+    }
+
+    /// Map storage for at least \p count elements, reporting the capacity
+    /// of the whole pages mapped.
+    ///
+    /// \param count The number of elements.
+    ///
+    /// \return The storage and its real capacity.
+    AllocationResult<value_type*> allocate_at_least(std::size_t count)
+    {
+        std::size_t bytes = _PageRound(sizeof(value_type) * count);
+        void* ptr = mmap(nullptr,
+                         bytes,
+                         PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS,
+                         -1,
+                         0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        return { static_cast<value_type*>(ptr), bytes / sizeof(value_type) };
+    }
+
+    /// Resize the mapping at \p ptr to hold \p newCount elements, by
+    /// re-mapping its pages rather than copying them.
+    ///
+    /// \param ptr The existing mapping, or \p nullptr.
+    /// \param oldCount The number of elements in the existing mapping.
+    /// \param newCount The number of elements to resize to.
+    ///
+    /// \return Pointer to the resized mapping, which may differ from \p ptr.
+    value_type* reallocate(value_type* ptr,
+                           std::size_t oldCount,
+                           std::size_t newCount)
+    {
+        if (ptr == nullptr) {
+            return allocate(newCount);
+        }
+
+        void* newPtr = mremap(ptr,
+                              _PageRound(sizeof(value_type) * oldCount),
+                              _PageRound(sizeof(value_type) * newCount),
+                              MREMAP_MAYMOVE);
+        if (newPtr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<value_type*>(newPtr);
+    }
+
+    /// Un-map storage previously returned by \ref allocate or
+    /// \ref reallocate.
+    ///
+    /// \param ptr The allocation.
+    /// \param count The number of elements in the allocation.
+    void deallocate(value_type* ptr, std::size_t count) noexcept
+    {
+        munmap(ptr, _PageRound(sizeof(value_type) * count));
+    }
+
+    template<typename OtherT>
+    bool operator==(const MmapAllocator<OtherT>&) const noexcept
+    {
+        return true;
+    }
+
+private:
+    static std::size_t _PageRound(std::size_t bytes)
+    {
+        static const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+        return std::max((bytes + pageSize - 1) / pageSize * pageSize,
+                        pageSize);
+    }
+};
+
+/// \typedef HugeVector
+///
+/// A \ref Vector for multi-gigabyte buffers: storage is mapped with
+/// \ref MmapAllocator, and capacity is rounded up to whole pages.  Growth
+/// of trivially relocatable elements happens via \p mremap, without copies.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam GrowthPolicyT The growth policy, before page rounding.
+template<typename ValueT, typename GrowthPolicyT = DoublingGrowth>
+using HugeVector = Vector<ValueT,
+                          MmapAllocator<ValueT>,
+                          PageRoundedGrowth<GrowthPolicyT>>;
@@ -0,0 +1,530 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "allocator.h"
+
+/// \class MpmcQueue
+///
+/// A bounded queue which any number of producer and consumer threads may use
+/// at once, without locks.
+///
+/// Elements live in a ring of cells, each with a sequence number recording
+/// which lap of the ring it is ready for (after Dmitry Vyukov's bounded MPMC
+/// queue).  Producers and consumers each claim positions with a
+/// compare-and-swap on their own cache line, then hand the cell over by
+/// storing its next sequence number, so that threads only contend on the
+/// cells they actually share.
+///
+/// The \p try_ operations never wait.  The blocking and timed operations spin
+/// and yield for a short while, then park the thread on a futex until the
+/// other side makes progress, so that a stalled queue costs no CPU, and a full
+/// queue applies backpressure to producers rather than growing.
+///
+/// A claimed cell must always be handed over, or the other side would wait
+/// on it forever, so elements are only moved into and out of cells with
+/// operations which cannot throw.  Elements whose construction may throw
+/// are constructed before their cell is claimed.
+///
+/// \tparam ValueT The type of each element, which must be nothrow move
+/// constructible and assignable.
+template<typename ValueT>
+class MpmcQueue
+{
+    static_assert(std::is_nothrow_move_constructible_v<ValueT> &&
+                      std::is_nothrow_move_assignable_v<ValueT>,
+                  "Elements must be moved without throwing.");
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// Constructs an empty queue.
+    ///
+    /// \param capacity The minimum number of elements the queue can hold,
+    /// rounded up to a power of two of at least 2.
+    explicit MpmcQueue(size_type capacity)
+      : m_capacity(std::bit_ceil(std::max<size_type>(capacity, 2)))
+      , m_cells(m_allocator.allocate(m_capacity))
+    {
+        for (size_type index = 0; index < m_capacity; ++index) {
+            ::new (static_cast<void*>(m_cells + index)) _Cell(index);
+        }
+    }
+
+    /// Destroys the remaining elements.  Must not race with any other
+    /// operation.
+    ~MpmcQueue()
+    {
+        size_type tail = m_enqueuePos.load(std::memory_order_acquire);
+        for (size_type pos = m_dequeuePos.load(std::memory_order_relaxed);
+             pos != tail;
+             ++pos) {
+            std::destroy_at(_CellAt(pos).Element());
+        }
+        std::destroy_n(m_cells, m_capacity);
+        m_allocator.deallocate(m_cells, m_capacity);
+    }
+
+    // Threads hold the queue by reference.
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /// Get the number of elements the queue can hold.
+    size_type capacity() const { return m_capacity; }
+
+    /// Get the number of elements in the queue, including those still being
+    /// pushed or popped.  Only exact when no operation is in progress.
+    size_type size_approx() const
+    {
+        size_type head = m_dequeuePos.load(std::memory_order_acquire);
+        size_type tail = m_enqueuePos.load(std::memory_order_acquire);
+        return tail > head ? std::min(tail - head, m_capacity) : 0;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Non-blocking operations
+    // -----------------------------------------------------------------------
+
+    /// Append an element constructed in-place with \p args, if there is
+    /// room.  If the construction may throw, the element is instead
+    /// constructed up-front, then moved into place.
+    ///
+    /// \param args The constructor arguments.
+    ///
+    /// \return Whether the element was appended.
+    template<typename... ArgsT>
+    bool try_emplace(ArgsT&&... args)
+    {
+        if constexpr (!std::is_nothrow_constructible_v<value_type, ArgsT...>) {
+            value_type value(std::forward<ArgsT>(args)...);
+            return try_emplace(std::move(value));
+        }
+
+        size_type pos;
+        if (_Claim(m_enqueuePos, 0, 1, pos) == 0) {
+            return false;
+        }
+
+        _Cell& cell = _CellAt(pos);
+        ::new (static_cast<void*>(cell.storage))
+            value_type(std::forward<ArgsT>(args)...);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        _Notify(m_pushEpoch, m_popWaiters, 1);
+        return true;
+    }
+
+    /// Append a copy of \p value, if there is room.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Whether the element was appended.
+    bool try_push(const value_type& value) { return try_emplace(value); }
+
+    /// Append \p value by move, if there is room.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Whether the element was appended.
+    bool try_push(value_type&& value) { return try_emplace(std::move(value)); }
+
+    /// Remove the front element into \p value, if there is one.
+    ///
+    /// \param value Receives the element.
+    ///
+    /// \return Whether an element was removed.
+    bool try_pop(value_type& value)
+    {
+        size_type pos;
+        if (_Claim(m_dequeuePos, 1, 1, pos) == 0) {
+            return false;
+        }
+
+        _Cell& cell = _CellAt(pos);
+        value_type* element = cell.Element();
+        value = std::move(*element);
+        std::destroy_at(element);
+        cell.sequence.store(pos + m_capacity, std::memory_order_release);
+        _Notify(m_popEpoch, m_pushWaiters, 1);
+        return true;
+    }
+
+    /// Append copies of as many of the \p count elements at \p values as
+    /// there is consecutive room for, claiming their cells at once.  If the
+    /// copies may throw, each is instead made before claiming its cell.
+    ///
+    /// \param values The elements.
+    /// \param count The number of elements.
+    ///
+    /// \return The number of elements appended, from the front.
+    size_type try_push_batch(const value_type* values, size_type count)
+    {
+        if constexpr (!std::is_nothrow_copy_constructible_v<value_type>) {
+            size_type pushed = 0;
+            while (pushed < count && try_push(values[pushed])) {
+                pushed++;
+            }
+            return pushed;
+        }
+
+        size_type pos;
+        count = _Claim(m_enqueuePos, 0, count, pos);
+        for (size_type index = 0; index < count; ++index) {
+            _Cell& cell = _CellAt(pos + index);
+            ::new (static_cast<void*>(cell.storage)) value_type(values[index]);
+            cell.sequence.store(pos + index + 1, std::memory_order_release);
+        }
+        _Notify(m_pushEpoch, m_popWaiters, count);
+        return count;
+    }
+
+    /// Remove up to \p maxCount consecutive front elements into \p values,
+    /// claiming their cells at once.
+    ///
+    /// \param values Receives the elements.
+    /// \param maxCount The maximum number of elements to remove.
+    ///
+    /// \return The number of elements removed.
+    size_type try_pop_batch(value_type* values, size_type maxCount)
+    {
+        size_type pos;
+        size_type count = _Claim(m_dequeuePos, 1, maxCount, pos);
+        for (size_type index = 0; index < count; ++index) {
+            _Cell& cell = _CellAt(pos + index);
+            value_type* element = cell.Element();
+            values[index] = std::move(*element);
+            std::destroy_at(element);
+            cell.sequence.store(pos + index + m_capacity,
+                                std::memory_order_release);
+        }
+        _Notify(m_popEpoch, m_pushWaiters, count);
+        return count;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Blocking operations
+    // -----------------------------------------------------------------------
+
+    /// Append a copy of \p value, waiting for room.
+    ///
+    /// \param value The element value.
+    void push(const value_type& value)
+    {
+        _Wait(m_popEpoch, m_pushWaiters, _NoDeadline(), [&] {
+            return try_push(value);
+        });
+    }
+
+    /// Append \p value by move, waiting for room.
+    ///
+    /// \param value The element value.
+    void push(value_type&& value)
+    {
+        _Wait(m_popEpoch, m_pushWaiters, _NoDeadline(), [&] {
+            return try_push(std::move(value));
+        });
+    }
+
+    /// Remove the front element into \p value, waiting for one.
+    ///
+    /// \param value Receives the element.
+    void pop(value_type& value)
+    {
+        _Wait(m_pushEpoch, m_popWaiters, _NoDeadline(), [&] {
+            return try_pop(value);
+        });
+    }
+
+    /// Append all \p count elements at \p values, waiting for room as
+    /// needed.
+    ///
+    /// \param values The elements.
+    /// \param count The number of elements.
+    void push_batch(const value_type* values, size_type count)
+    {
+        size_type pushed = 0;
+        _Wait(m_popEpoch, m_pushWaiters, _NoDeadline(), [&] {
+            pushed += try_push_batch(values + pushed, count - pushed);
+            return pushed == count;
+        });
+    }
+
+    /// Remove between 1 and \p maxCount front elements into \p values,
+    /// waiting for at least one.
+    ///
+    /// \param values Receives the elements.
+    /// \param maxCount The maximum number of elements to remove, not 0.
+    ///
+    /// \return The number of elements removed.
+    size_type pop_batch(value_type* values, size_type maxCount)
+    {
+        size_type popped = 0;
+        _Wait(m_pushEpoch, m_popWaiters, _NoDeadline(), [&] {
+            popped = try_pop_batch(values, maxCount);
+            return popped != 0;
+        });
+        return popped;
+    }
+
+    /// Append a copy of \p value, waiting at most \p timeout for room.
+    ///
+    /// \param value The element value.
+    /// \param timeout The longest time to wait.
+    ///
+    /// \return Whether the element was appended.
+    template<typename RepT, typename PeriodT>
+    bool try_push_for(const value_type& value,
+                      std::chrono::duration<RepT, PeriodT> timeout)
+    {
+        return _Wait(m_popEpoch, m_pushWaiters, _DeadlineAfter(timeout), [&] {
+            return try_push(value);
+        });
+    }
+
+    /// Remove the front element into \p value, waiting at most \p timeout
+    /// for one.
+    ///
+    /// \param value Receives the element.
+    /// \param timeout The longest time to wait.
+    ///
+    /// \return Whether an element was removed.
+    template<typename RepT, typename PeriodT>
+    bool try_pop_for(value_type& value,
+                     std::chrono::duration<RepT, PeriodT> timeout)
+    {
+        return _Wait(m_pushEpoch, m_popWaiters, _DeadlineAfter(timeout), [&] {
+            return try_pop(value);
+        });
+    }
+
+private:
+    using _Clock = std::chrono::steady_clock;
+
+    static constexpr size_type s_cacheLineSize = 64;
+
+    // Number of attempts made by the blocking operations while spinning, then
+    // while yielding to other threads, before parking.
+    static constexpr int s_spinCount = 64;
+    static constexpr int s_yieldCount = 16;
+
+    // A slot of the ring.  A cell at position pos holds no element when its
+    // sequence is pos, and holds one when its sequence is pos + 1.  Popping
+    // advances the sequence by a lap, to pos + capacity.
+    struct _Cell
+    {
+        explicit _Cell(size_type index)
+          : sequence(index)
+        {}
+
+        value_type* Element()
+        {
+            return std::launder(reinterpret_cast<value_type*>(storage));
+        }
+
+        std::atomic<size_type> sequence;
+        alignas(value_type) std::byte storage[sizeof(value_type)];
+    };
+
+    _Cell& _CellAt(size_type pos) { return m_cells[pos & (m_capacity - 1)]; }
+
+    static _Clock::time_point _NoDeadline()
+    {
+        return _Clock::time_point::max();
+    }
+
+    // The time \p timeout from now, saturated to \ref _NoDeadline.  The
+    // comparison is made in floating point, as converting a long timeout to
+    // clock ticks would overflow.
+    template<typename RepT, typename PeriodT>
+    static _Clock::time_point _DeadlineAfter(
+        std::chrono::duration<RepT, PeriodT> timeout)
+    {
+        _Clock::time_point now = _Clock::now();
+        if (std::chrono::duration<double>(timeout) >=
+            std::chrono::duration<double>(_NoDeadline() - now)) {
+            return _NoDeadline();
+        }
+        return now + std::chrono::duration_cast<_Clock::duration>(timeout);
+    }
+
+    // Claim up to \p maxCount consecutive positions from \p position, whose
+    // cells' sequences are the position plus \p offset (0 to push into a
+    // free cell, 1 to pop from a filled one).
+    //
+    // \return The number of positions claimed, starting at \p pos.
+    size_type _Claim(std::atomic<size_type>& position,
+                     size_type offset,
+                     size_type maxCount,
+                     size_type& pos)
+    {
+        pos = position.load(std::memory_order_relaxed);
+        for (;;) {
+            // Count the ready cells.  Once ready for pos, a cell can only be
+            // changed by the thread which claims pos.
+            size_type count = 0;
+            std::ptrdiff_t diff = 0;
+            while (count < maxCount) {
+                size_type sequence = _CellAt(pos + count)
+                                         .sequence.load(
+                                             std::memory_order_acquire);
+                diff = std::ptrdiff_t(sequence - (pos + count + offset));
+                if (diff != 0) {
+                    break;
+                }
+                count++;
+            }
+
+            if (count != 0) {
+                if (position.compare_exchange_weak(
+                        pos, pos + count, std::memory_order_relaxed)) {
+                    return count;
+                }
+            } else if (diff < 0 || maxCount == 0) {
+                // The first cell is a lap behind: full, or empty.  Or
+                // nothing was asked for.
+                return 0;
+            } else {
+                // Another thread claimed pos.
+                pos = position.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Wake up to \p count threads parked on \p epoch, if there are any.
+    static void _Notify(std::atomic<std::uint32_t>& epoch,
+                        std::atomic<std::uint32_t>& waiters,
+                        size_type count)
+    {
+        // Order the hand-off of the cells before the check for waiters,
+        // against the waiter's registration before its final attempt.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (count == 0 || waiters.load(std::memory_order_relaxed) == 0) {
+            return;
+        }
+
+        epoch.fetch_add(1, std::memory_order_release);
+        syscall(SYS_futex,
+                reinterpret_cast<std::uint32_t*>(&epoch),
+                FUTEX_WAKE_PRIVATE,
+                int(std::min<size_type>(count, INT_MAX)),
+                nullptr,
+                nullptr,
+                0);
+    }
+
+    // Call \p attemptFn until it succeeds, spinning, then parking on
+    // \p epoch until the other side notifies it, or \p deadline passes.
+    //
+    // \return Whether \p attemptFn succeeded.
+    template<typename AttemptFnT>
+    static bool _Wait(std::atomic<std::uint32_t>& epoch,
+                      std::atomic<std::uint32_t>& waiters,
+                      _Clock::time_point deadline,
+                      AttemptFnT&& attemptFn)
+    {
+        for (int spin = 0; spin < s_spinCount; ++spin) {
+            if (attemptFn()) {
+                return true;
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        for (int yield = 0; yield < s_yieldCount; ++yield) {
+            if (attemptFn()) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+
+        for (;;) {
+            std::uint32_t observed = epoch.load(std::memory_order_acquire);
+            waiters.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool succeeded = attemptFn();
+            if (!succeeded) {
+                _Park(epoch, observed, deadline);
+            }
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+
+            if (succeeded || attemptFn()) {
+                return true;
+            }
+            if (_Clock::now() >= deadline) {
+                return false;
+            }
+        }
+    }
+
+    // Sleep while \p epoch is \p observed, until \p deadline at the latest.
+    // May return early.
+    static void _Park(std::atomic<std::uint32_t>& epoch,
+                      std::uint32_t observed,
+                      _Clock::time_point deadline)
+    {
+        timespec timeout;
+        timespec* timeoutPtr = nullptr;
+        if (deadline != _NoDeadline()) {
+            auto remaining =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    deadline - _Clock::now());
+            if (remaining.count() <= 0) {
+                return;
+            }
+            timeout.tv_sec = remaining.count() / 1'000'000'000;
+            timeout.tv_nsec = remaining.count() % 1'000'000'000;
+            timeoutPtr = &timeout;
+        }
+
+        syscall(SYS_futex,
+                reinterpret_cast<std::uint32_t*>(&epoch),
+                FUTEX_WAIT_PRIVATE,
+                observed,
+                timeoutPtr,
+                nullptr,
+                0);
+    }
+
+    [[no_unique_address]] MallocAllocator<_Cell> m_allocator;
+    const size_type m_capacity;
+    _Cell* const m_cells;
+
+    // Position of the next push.
+    alignas(s_cacheLineSize) std::atomic<size_type> m_enqueuePos = 0;
+
+    // Position of the next pop.
+    alignas(s_cacheLineSize) std::atomic<size_type> m_dequeuePos = 0;
+
+    // Advanced on pushes which find parked consumers, and the number of
+    // consumers parked on it.
+    alignas(s_cacheLineSize) std::atomic<std::uint32_t> m_pushEpoch = 0;
+    std::atomic<std::uint32_t> m_popWaiters = 0;
+
+    // Advanced on pops which find parked producers, and the number of
+    // producers parked on it.
+    alignas(s_cacheLineSize) std::atomic<std::uint32_t> m_popEpoch = 0;
+    std::atomic<std::uint32_t> m_pushWaiters = 0;
+};
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include "allocator.h"
+
+/// \class ObjectPool
+///
+/// A fixed set of objects which threads borrow and return, so that objects
+/// handed between threads are recycled rather than allocated and freed
+/// each time.
+///
+/// All the objects are constructed up front, in storage which never moves.
+/// The free objects form a lock-free stack, linked by index, whose head
+/// carries a counter bumped on every change so that a stale head cannot be
+/// mistaken for the current one.  Acquiring and releasing are each a single
+/// compare-and-swap, and the most recently released object, which is the
+/// most likely to be in cache, is the next one acquired.
+///
+/// A released object keeps its value: the next borrower is responsible for
+/// resetting whatever state it relies on.
+///
+/// \tparam ValueT The type of each object.
+template<typename ValueT>
+class ObjectPool
+{
+public:
+    /// \typedef value_type
+    ///
+    /// The type of each object.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// Constructs a pool of \p capacity objects, each a copy of \p value.
+    ///
+    /// \param capacity The number of objects.  Should be at least the most
+    /// objects that are borrowed at once, such as the number of tokens of a
+    /// pipeline, so that acquiring never waits.
+    /// \param value The initial value of each object.
+    ///
+    /// \throws std::length_error If \p capacity exceeds the range of the
+    /// 32-bit indices which link the free objects.
+    explicit ObjectPool(size_type capacity,
+                        const value_type& value = value_type())
+      : m_capacity(_CheckCapacity(capacity))
+      , m_objects(m_allocator.allocate(m_capacity))
+      , m_next(std::make_unique<std::atomic<std::uint32_t>[]>(m_capacity))
+    {
+        std::uninitialized_fill_n(m_objects, m_capacity, value);
+        for (size_type index = 0; index < m_capacity; ++index) {
+            m_next[index].store(
+                index + 1 < m_capacity ? std::uint32_t(index + 1) : s_null,
+                std::memory_order_relaxed);
+        }
+        m_head.store(m_capacity != 0 ? 0 : s_null, std::memory_order_relaxed);
+    }
+
+    /// Destroys the objects.  All of them must have been released.
+    ~ObjectPool()
+    {
+        std::destroy_n(m_objects, m_capacity);
+        m_allocator.deallocate(m_objects, m_capacity);
+    }
+
+    // Borrowers hold pointers into the pool.
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// Get the number of objects in the pool.
+    size_type capacity() const { return m_capacity; }
+
+    /// Borrow an object, if any is free.
+    ///
+    /// \return The object, or \p nullptr if all of them are borrowed.
+    value_type* try_acquire()
+    {
+        std::uint64_t head = m_head.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint32_t index = _Index(head);
+            if (index == s_null) {
+                return nullptr;
+            }
+
+            // The object may be acquired and released again meanwhile, in
+            // which case the counter fails the exchange.
+            std::uint32_t next = m_next[index].load(std::memory_order_relaxed);
+            if (m_head.compare_exchange_weak(head,
+                                             _Head(head, next),
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire)) {
+                return m_objects + index;
+            }
+        }
+    }
+
+    /// Borrow an object, yielding to other threads until one is released if
+    /// all of them are borrowed.  This waits forever if no other thread ever
+    /// releases one, so use \ref try_acquire where the capacity is meant to
+    /// cover every borrower.
+    ///
+    /// \return The object.
+    value_type* acquire()
+    {
+        value_type* object = try_acquire();
+        while (object == nullptr) {
+            std::this_thread::yield();
+            object = try_acquire();
+        }
+        return object;
+    }
+
+    /// Return \p object, previously borrowed from this pool.
+    ///
+    /// \param object The object.
+    void release(value_type* object)
+    {
+        std::uint32_t index = std::uint32_t(object - m_objects);
+        std::uint64_t head = m_head.load(std::memory_order_relaxed);
+        do {
+            m_next[index].store(_Index(head), std::memory_order_relaxed);
+        } while (!m_head.compare_exchange_weak(head,
+                                               _Head(head, index),
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+private:
+    static constexpr std::uint32_t s_null = UINT32_MAX;
+
+    // Every index must differ from s_null.
+    static size_type _CheckCapacity(size_type capacity)
+    {
+        if (capacity > s_null) {
+            throw std::length_error("Pool capacity is out of range.");
+        }
+        return capacity;
+    }
+
+    // The head packs the index of the top free object in its low half, and
+    // the change counter in its high half.
+    static std::uint32_t _Index(std::uint64_t head)
+    {
+        return std::uint32_t(head);
+    }
+
+    // The head following \p head, with \p index on top.
+    static std::uint64_t _Head(std::uint64_t head, std::uint32_t index)
+    {
+        return ((head >> 32) + 1) << 32 | index;
+    }
+
+    [[no_unique_address]] MallocAllocator<value_type> m_allocator;
+    const size_type m_capacity;
+    value_type* const m_objects;
+
+    // The index of the free object below each free object on the stack.
+    std::unique_ptr<std::atomic<std::uint32_t>[]> m_next;
+
+    // The index of the top free object, and the change counter.
+    std::atomic<std::uint64_t> m_head;
+};
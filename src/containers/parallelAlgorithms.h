@@ -0,0 +1,249 @@
+#pragma once
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "vector.h"
+
+// Parallel counterparts of \ref Vector operations, built on TBB, for vectors
+// large enough to amortize the cost of spawning tasks.  Vectors of up to
+// \p grainSize elements are processed serially.
+//
+// Operations which size a vector do so with \ref DefaultInit before writing
+// its elements in parallel.  For trivial types, freshly allocated pages are
+// therefore first touched by the worker thread which writes them, placing
+// them in memory local to that thread on NUMA systems.  Work is distributed
+// with \p tbb::static_partitioner, so subsequent loops over the same range
+// with the same partitioner tend to run on the same threads.
+
+// Invoke \p fn(begin, end) in parallel over index ranges covering
+// [0, count).
+template<typename FnT>
+void _ParallelForRanges(std::size_t count, std::size_t grainSize, FnT fn)
+{
+    tbb::parallel_for(
+        tbb::blocked_range<std::size_t>(0, count, grainSize),
+        [&](const tbb::blocked_range<std::size_t>& range) {
+            fn(range.begin(), range.end());
+        },
+        tbb::static_partitioner());
+}
+
+// Copy-assign \p count elements from \p src over \p dst, in parallel.
+template<typename ValueT>
+void _ParallelCopyElements(const ValueT* src,
+                           std::size_t count,
+                           ValueT* dst,
+                           std::size_t grainSize)
+{
+    _ParallelForRanges(
+        count, grainSize, [&](std::size_t begin, std::size_t end) {
+            if constexpr (std::is_trivially_copyable<ValueT>::value) {
+                memcpy(
+                    dst + begin, src + begin, sizeof(ValueT) * (end - begin));
+            } else {
+                std::copy(src + begin, src + end, dst + begin);
+            }
+        });
+}
+
+/// Make a copy of \p src, copying elements in parallel.
+///
+/// Non-trivial elements are default-constructed, then copy-assigned.
+///
+/// \param src The vector to copy.
+/// \param grainSize The minimum number of elements copied by each task.
+///
+/// \return The copy.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT>
+Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>
+ParallelCopy(
+    const Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& src,
+    std::size_t grainSize = 64 * 1024)
+{
+    using VectorT = Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>;
+
+    if (src.size() <= grainSize) {
+        return VectorT(src);
+    }
+
+    VectorT dst(std::allocator_traits<AllocatorT>::
+                    select_on_container_copy_construction(src.get_allocator()));
+    dst.resize(src.size(), DefaultInit);
+    _ParallelCopyElements(src.data(), src.size(), dst.data(), grainSize);
+    return dst;
+}
+
+/// Replace the elements of \p dst with copies of the elements of \p src,
+/// copying in parallel.
+///
+/// \param dst The vector to assign to.
+/// \param src The vector to copy.
+/// \param grainSize The minimum number of elements copied by each task.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT>
+void ParallelAssign(
+    Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& dst,
+    const Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& src,
+    std::size_t grainSize = 64 * 1024)
+{
+    if (&dst == &src) {
+        return;
+    }
+
+    if (src.size() <= grainSize) {
+        dst = src;
+        return;
+    }
+
+    dst.resize(src.size(), DefaultInit);
+    _ParallelCopyElements(src.data(), src.size(), dst.data(), grainSize);
+}
+
+/// Replace the elements of \p vec with \p count copies of \p value,
+/// filling in parallel.
+///
+/// \param vec The vector to assign to.
+/// \param count The number of elements.
+/// \param value The value of each element.
+/// \param grainSize The minimum number of elements filled by each task.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT>
+void
+ParallelAssign(Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& vec,
+               std::size_t count,
+               const std::type_identity_t<ValueT>& value,
+               std::size_t grainSize = 64 * 1024)
+{
+    if (count <= grainSize) {
+        vec.assign(count, value);
+        return;
+    }
+
+    vec.resize(count, DefaultInit);
+    ValueT* data = vec.data();
+    _ParallelForRanges(
+        count, grainSize, [&](std::size_t begin, std::size_t end) {
+            std::fill(data + begin, data + end, value);
+        });
+}
+
+/// Resize \p vec to contain \p count elements, filling the appended elements
+/// with \p value in parallel.
+///
+/// \param vec The vector to resize.
+/// \param count The number of elements.
+/// \param value The value of each appended element.
+/// \param grainSize The minimum number of elements filled by each task.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT>
+void
+ParallelResize(Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& vec,
+               std::size_t count,
+               const std::type_identity_t<ValueT>& value = ValueT(),
+               std::size_t grainSize = 64 * 1024)
+{
+    std::size_t oldSize = vec.size();
+    if (count <= oldSize || count - oldSize <= grainSize) {
+        vec.resize(count, value);
+        return;
+    }
+
+    vec.resize(count, DefaultInit);
+    ValueT* data = vec.data() + oldSize;
+    _ParallelForRanges(
+        count - oldSize, grainSize, [&](std::size_t begin, std::size_t end) {
+            std::fill(data + begin, data + end, value);
+        });
+}
+
+/// Erase all elements of \p vec satisfying \p predicate, in parallel.  The
+/// order of the remaining elements is preserved.
+///
+/// The vector is split into chunks of \p grainSize elements.  A first pass
+/// counts the remaining elements of each chunk, from which each chunk derives
+/// its offset into a new buffer, and a second pass moves the remaining
+/// elements of all chunks into it concurrently.  \p predicate is therefore
+/// invoked twice per element, and must be free of side effects.
+///
+/// \param vec The vector to erase from.
+/// \param predicate Returns \p true for elements to erase.
+/// \param grainSize The number of elements in each chunk.
+///
+/// \return The number of erased elements.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT,
+         typename PredicateT>
+std::size_t
+ParallelEraseIf(Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& vec,
+                const PredicateT& predicate,
+                std::size_t grainSize = 64 * 1024)
+{
+    using VectorT = Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>;
+
+    if (vec.size() <= grainSize) {
+        return vec.erase_if(predicate);
+    }
+
+    std::size_t numChunks = (vec.size() + grainSize - 1) / grainSize;
+    auto chunkBegin = [&](std::size_t chunk) {
+        return vec.data() + chunk * grainSize;
+    };
+    auto chunkEnd = [&](std::size_t chunk) {
+        return vec.data() + std::min((chunk + 1) * grainSize, vec.size());
+    };
+
+    // Count the remaining elements of each chunk, then convert the counts
+    // into offsets (offsets[chunk] is the destination of the first remaining
+    // element of chunk).
+    Vector<std::size_t> offsets(numChunks + 1, DefaultInit);
+    offsets[0] = 0;
+    tbb::parallel_for(std::size_t(0), numChunks, [&](std::size_t chunk) {
+        offsets[chunk + 1] = std::count_if(
+            chunkBegin(chunk), chunkEnd(chunk), [&](const ValueT& value) {
+                return !predicate(value);
+            });
+    });
+    for (std::size_t chunk = 0; chunk < numChunks; ++chunk) {
+        offsets[chunk + 1] += offsets[chunk];
+    }
+
+    std::size_t remainingCount = offsets[numChunks];
+    std::size_t erasedCount = vec.size() - remainingCount;
+    if (erasedCount == 0) {
+        return 0;
+    }
+
+    // Move the remaining elements of each chunk into the new buffer.
+    VectorT compacted(vec.get_allocator());
+    compacted.resize(remainingCount, DefaultInit);
+    tbb::parallel_for(std::size_t(0), numChunks, [&](std::size_t chunk) {
+        ValueT* dst = compacted.data() + offsets[chunk];
+        for (ValueT* src = chunkBegin(chunk); src != chunkEnd(chunk); ++src) {
+            if (!predicate(*src)) {
+                *dst = std::move(*src);
+                ++dst;
+            }
+        }
+    });
+
+    vec.swap(compacted);
+    return erasedCount;
+}
@@ -0,0 +1,557 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.h"
+#include "vector.h"
+
+/// \class SegmentedVector
+///
+/// An array stored as a table of fixed-size chunks, so that growing never
+/// copies or moves existing elements: references to them remain valid until
+/// they are removed, or the vector is destroyed.
+///
+/// Random access is a shift and a mask to find the chunk and the offset
+/// within it, followed by one indirection through the chunk table.  Each
+/// chunk is contiguous, and may be visited on its own with \ref chunk, for
+/// example from a \p tbb::parallel_for over \ref chunk_count.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam ChunkSizeV The number of elements in each chunk, a power of two.
+/// Defaults to about 16KB worth of elements.
+/// \tparam AllocatorT Allocates each chunk.
+template<typename ValueT,
+         std::size_t ChunkSizeV =
+             std::bit_ceil(std::max<std::size_t>(16, 16384 / sizeof(ValueT))),
+         typename AllocatorT = MallocAllocator<ValueT>>
+class SegmentedVector
+{
+    static_assert(std::has_single_bit(ChunkSizeV),
+                  "The chunk size must be a power of two.");
+
+    static constexpr int s_chunkSizeLog2 = std::countr_zero(ChunkSizeV);
+
+    // Random access iterator over the elements, in a mutable or read-only
+    // fashion.
+    template<typename VectorT, typename ElementT>
+    class _Iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<ElementT>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = ElementT*;
+        using reference = ElementT&;
+
+        _Iterator() = default;
+
+        _Iterator(VectorT* vector, std::size_t index)
+          : m_vector(vector)
+          , m_index(index)
+        {}
+
+        /// Converting constructor, from a mutable to a read-only iterator.
+        template<typename OtherVectorT, typename OtherElementT>
+        _Iterator(const _Iterator<OtherVectorT, OtherElementT>& other)
+            requires(std::is_const_v<ElementT> &&
+                     !std::is_const_v<OtherElementT>)
+          : m_vector(other.m_vector)
+          , m_index(other.m_index)
+        {}
+
+        reference operator*() const { return (*m_vector)[m_index]; }
+
+        pointer operator->() const { return &(*m_vector)[m_index]; }
+
+        reference operator[](difference_type offset) const
+        {
+            return (*m_vector)[m_index + offset];
+        }
+
+        _Iterator& operator++()
+        {
+            ++m_index;
+            return *this;
+        }
+
+        _Iterator operator++(int)
+        {
+            _Iterator copy = *this;
+            ++m_index;
+            return copy;
+        }
+
+        _Iterator& operator--()
+        {
+            --m_index;
+            return *this;
+        }
+
+        _Iterator operator--(int)
+        {
+            _Iterator copy = *this;
+            --m_index;
+            return copy;
+        }
+
+        _Iterator& operator+=(difference_type offset)
+        {
+            m_index += offset;
+            return *this;
+        }
+
+        _Iterator& operator-=(difference_type offset)
+        {
+            m_index -= offset;
+            return *this;
+        }
+
+        _Iterator operator+(difference_type offset) const
+        {
+            return _Iterator(m_vector, m_index + offset);
+        }
+
+        friend _Iterator operator+(difference_type offset,
+                                   const _Iterator& iterator)
+        {
+            return iterator + offset;
+        }
+
+        _Iterator operator-(difference_type offset) const
+        {
+            return _Iterator(m_vector, m_index - offset);
+        }
+
+        difference_type operator-(const _Iterator& other) const
+        {
+            return difference_type(m_index) - difference_type(other.m_index);
+        }
+
+        bool operator==(const _Iterator& other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        auto operator<=>(const _Iterator& other) const
+        {
+            return m_index <=> other.m_index;
+        }
+
+    private:
+        template<typename, typename>
+        friend class _Iterator;
+
+        VectorT* m_vector = nullptr;
+        std::size_t m_index = 0;
+    };
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef allocator_type
+    ///
+    /// The allocator type.
+    using allocator_type = AllocatorT;
+
+    /// \typedef iterator
+    ///
+    /// Iterator over the elements, in a mutable fashion.
+    using iterator = _Iterator<SegmentedVector, value_type>;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the elements, in a read-only fashion.
+    using const_iterator = _Iterator<const SegmentedVector, const value_type>;
+
+    /// The number of elements in each chunk.
+    static constexpr size_type chunk_size = ChunkSizeV;
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Default constructor.
+    SegmentedVector() = default;
+
+    /// Constructs an empty vector, with an allocator instance.
+    ///
+    /// \param allocator The allocator instance.
+    explicit SegmentedVector(const AllocatorT& allocator)
+      : m_allocator(allocator)
+    {}
+
+    // The constructors below which fill the vector delegate to one which
+    // leaves it empty, so that should an element throw, the destructor runs
+    // and frees the elements and chunks constructed so far.
+
+    /// Constructs a vector with \p count value-initialized elements.
+    ///
+    /// \param count The number of elements.
+    explicit SegmentedVector(size_type count)
+      : SegmentedVector()
+    {
+        resize(count);
+    }
+
+    /// Constructs a vector with \p count copies of \p value.
+    ///
+    /// \param count The number of elements.
+    /// \param value The value of each element.
+    SegmentedVector(size_type count, const value_type& value)
+      : SegmentedVector()
+    {
+        resize(count, value);
+    }
+
+    /// Copy constructor.
+    ///
+    /// \param src The source vector to copy the elements of.
+    SegmentedVector(const SegmentedVector& src)
+      : SegmentedVector(src.m_allocator)
+    {
+        reserve(src.m_size);
+        for (const value_type& value : src) {
+            push_back(value);
+        }
+    }
+
+    /// Move constructor.
+    ///
+    /// \param src The source vector to take the chunks of.
+    SegmentedVector(SegmentedVector&& src) noexcept
+      : m_allocator(src.m_allocator)
+      , m_chunks(std::move(src.m_chunks))
+      , m_size(std::exchange(src.m_size, 0))
+    {}
+
+    /// Destroys the elements, and frees the chunks.
+    ~SegmentedVector()
+    {
+        clear();
+        _FreeChunks(0);
+    }
+
+    /// Copy assignment.
+    ///
+    /// \param src The source vector to copy the elements of.
+    SegmentedVector& operator=(const SegmentedVector& src)
+    {
+        if (this != &src) {
+            SegmentedVector copy(src);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    /// Move assignment.
+    ///
+    /// \param src The source vector to take the chunks of.
+    SegmentedVector& operator=(SegmentedVector&& src) noexcept
+    {
+        if (this != &src) {
+            SegmentedVector moved(std::move(src));
+            swap(moved);
+        }
+        return *this;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access an element, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& operator[](size_type index) const
+    {
+        return m_chunks[index >> s_chunkSizeLog2][index & (chunk_size - 1)];
+    }
+
+    /// Access an element, in a mutable fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    value_type& operator[](size_type index)
+    {
+        return m_chunks[index >> s_chunkSizeLog2][index & (chunk_size - 1)];
+    }
+
+    /// Access an element with bounds checking, in a read-only fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& at(size_type index) const
+    {
+        if (index >= m_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return (*this)[index];
+    }
+
+    /// Access an element with bounds checking, in a mutable fashion.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    value_type& at(size_type index)
+    {
+        if (index >= m_size) {
+            throw std::out_of_range("Index is out of range.");
+        }
+
+        return (*this)[index];
+    }
+
+    /// Access the first element, in a read-only fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    const value_type& front() const { return (*this)[0]; }
+
+    /// Access the first element, in a mutable fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    value_type& front() { return (*this)[0]; }
+
+    /// Access the last element, in a read-only fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    const value_type& back() const { return (*this)[m_size - 1]; }
+
+    /// Access the last element, in a mutable fashion.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    value_type& back() { return (*this)[m_size - 1]; }
+
+    // -----------------------------------------------------------------------
+    /// \name Chunks
+    // -----------------------------------------------------------------------
+
+    /// Get the number of chunks holding elements.
+    size_type chunk_count() const
+    {
+        return (m_size + chunk_size - 1) >> s_chunkSizeLog2;
+    }
+
+    /// Get the elements of a chunk, in a read-only fashion.  Every chunk but
+    /// the last is full.
+    ///
+    /// \param chunkIndex The index of the chunk, less than \ref chunk_count.
+    ///
+    /// \return The contiguous elements of the chunk.
+    std::span<const value_type> chunk(size_type chunkIndex) const
+    {
+        return { m_chunks[chunkIndex], _ChunkLength(chunkIndex) };
+    }
+
+    /// Get the elements of a chunk, in a mutable fashion.  Every chunk but
+    /// the last is full.
+    ///
+    /// \param chunkIndex The index of the chunk, less than \ref chunk_count.
+    ///
+    /// \return The contiguous elements of the chunk.
+    std::span<value_type> chunk(size_type chunkIndex)
+    {
+        return { m_chunks[chunkIndex], _ChunkLength(chunkIndex) };
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Iterators
+    // -----------------------------------------------------------------------
+
+    /// Get an iterator to the first element, in a mutable fashion.
+    iterator begin() { return iterator(this, 0); }
+
+    /// Get an iterator past the last element, in a mutable fashion.
+    iterator end() { return iterator(this, m_size); }
+
+    /// Get an iterator to the first element, in a read-only fashion.
+    const_iterator begin() const { return const_iterator(this, 0); }
+
+    /// Get an iterator past the last element, in a read-only fashion.
+    const_iterator end() const { return const_iterator(this, m_size); }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if there are no elements.
+    bool empty() const { return m_size == 0; }
+
+    /// Get the number of elements.
+    size_type size() const { return m_size; }
+
+    /// Get the number of elements which fit in the allocated chunks.
+    size_type capacity() const { return m_chunks.size() * chunk_size; }
+
+    /// Allocate the chunks needed to hold \p count elements.
+    ///
+    /// \param count The number of elements.
+    void reserve(size_type count)
+    {
+        size_type chunkCount = (count + chunk_size - 1) >> s_chunkSizeLog2;
+        if (chunkCount > m_chunks.size()) {
+            m_chunks.reserve(chunkCount);
+            while (m_chunks.size() < chunkCount) {
+                m_chunks.push_back(m_allocator.allocate(chunk_size));
+            }
+        }
+    }
+
+    /// Free the chunks which hold no elements.
+    void shrink_to_fit() { _FreeChunks(chunk_count()); }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Append an element constructed in-place with \p args.
+    ///
+    /// \param args The constructor arguments.
+    ///
+    /// \return The new element.
+    template<typename... ArgsT>
+    value_type& emplace_back(ArgsT&&... args)
+    {
+        if (m_size == capacity()) {
+            // Make room in the table first, so that the chunk cannot leak.
+            m_chunks.reserve(m_chunks.size() + 1);
+            m_chunks.push_back(m_allocator.allocate(chunk_size));
+        }
+
+        value_type* ptr = &(*this)[m_size];
+        ::new (static_cast<void*>(ptr))
+            value_type(std::forward<ArgsT>(args)...);
+        m_size++;
+        return *ptr;
+    }
+
+    /// Append a copy of \p value.
+    ///
+    /// \param value The element value.
+    void push_back(const value_type& value) { emplace_back(value); }
+
+    /// Append \p value by move.
+    ///
+    /// \param value The element value.
+    void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+    /// Remove the last element.
+    ///
+    /// \pre This results in undefined behavior if this vector is empty.
+    void pop_back()
+    {
+        std::destroy_at(&back());
+        m_size--;
+    }
+
+    /// Resize to \p count elements, value-initializing new elements.
+    ///
+    /// \param count The number of elements.
+    void resize(size_type count)
+    {
+        _Resize(count, [](value_type* ptr) {
+            ::new (static_cast<void*>(ptr)) value_type();
+        });
+    }
+
+    /// Resize to \p count elements, initializing new elements to \p value.
+    ///
+    /// \param count The number of elements.
+    /// \param value The value of new elements.
+    void resize(size_type count, const value_type& value)
+    {
+        _Resize(count, [&](value_type* ptr) {
+            ::new (static_cast<void*>(ptr)) value_type(value);
+        });
+    }
+
+    /// Destroy all elements, keeping the chunks allocated.
+    void clear()
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type chunkIndex = 0; chunkIndex < chunk_count();
+                 ++chunkIndex) {
+                std::span<value_type> elements = chunk(chunkIndex);
+                std::destroy(elements.begin(), elements.end());
+            }
+        }
+        m_size = 0;
+    }
+
+    /// Swap the contents of this vector with \p other.
+    ///
+    /// \param other The vector to swap with.
+    void swap(SegmentedVector& other) noexcept
+    {
+        std::swap(m_allocator, other.m_allocator);
+        m_chunks.swap(other.m_chunks);
+        std::swap(m_size, other.m_size);
+    }
+
+private:
+    // Number of elements held by \p chunkIndex.
+    size_type _ChunkLength(size_type chunkIndex) const
+    {
+        return std::min(chunk_size, m_size - (chunkIndex << s_chunkSizeLog2));
+    }
+
+    // Shared functionality for resizing, constructing new elements with
+    // \p constructFn.
+    template<typename ConstructFnT>
+    void _Resize(size_type count, ConstructFnT&& constructFn)
+    {
+        if (count < m_size) {
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                for (size_type index = count; index < m_size; ++index) {
+                    std::destroy_at(&(*this)[index]);
+                }
+            }
+            m_size = count;
+            return;
+        }
+
+        reserve(count);
+        for (; m_size < count; ++m_size) {
+            constructFn(&(*this)[m_size]);
+        }
+    }
+
+    // Free the chunks from \p firstChunk onwards.
+    void _FreeChunks(size_type firstChunk)
+    {
+        while (m_chunks.size() > firstChunk) {
+            m_allocator.deallocate(m_chunks.back(), chunk_size);
+            m_chunks.pop_back();
+        }
+    }
+
+    AllocatorT m_allocator;
+
+    // Table of chunk buffers.
+    Vector<value_type*> m_chunks;
+
+    // Number of elements.
+    size_type m_size = 0;
+};
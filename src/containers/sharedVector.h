@@ -0,0 +1,421 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>    // O_* constants.
+#include <sys/mman.h> // shm_open, shm_unlink, mmap, mremap, munmap.
+#include <sys/stat.h> // fstat.
+#include <unistd.h>   // ftruncate, close.
+
+#include "growthPolicy.h"
+#include "mappedVector.h"
+
+/// \class SharedVector
+///
+/// A vector living in a named POSIX shared memory segment, which one process
+/// appends to and any number of processes read from, without copies.
+///
+/// The segment starts with a header holding the format version, the element
+/// size, the capacity, and the size.  The writer publishes appended elements
+/// by storing the size with release semantics, and readers observe them by
+/// loading it in \ref refresh with acquire semantics, so elements below the
+/// observed size are fully written.  Appended elements are never modified.
+/// The version is likewise published last when the segment is created, so
+/// readers which open it before then wait for the header to be written.
+///
+/// Capacity grows by extending the segment with \p ftruncate and re-mapping
+/// it.  Readers re-map their view in \ref refresh when the published size
+/// exceeds it.
+///
+/// \tparam ValueT The type of each element, which must be trivially
+/// copyable.
+/// \tparam GrowthPolicyT Computes the capacity to grow to.
+template<typename ValueT,
+         typename GrowthPolicyT = PageRoundedGrowth<DoublingGrowth>>
+class SharedVector
+{
+    static_assert(std::is_trivially_copyable<ValueT>::value,
+                  "Shared elements must be trivially copyable.");
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                      std::atomic<std::uint64_t>::is_always_lock_free,
+                  "Shared atomics must be lock-free to be address-free.");
+
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef const_iterator
+    ///
+    /// Iterator over the elements, in a read-only fashion.
+    using const_iterator = const value_type*;
+
+    /// The version of the segment layout.  Segments of other versions are
+    /// rejected.
+    static constexpr std::uint32_t version = 1;
+
+    /// How long a reader waits for the writer to publish the header of a
+    /// segment it is still creating.
+    static constexpr std::chrono::seconds openTimeout{1};
+
+    // -----------------------------------------------------------------------
+    /// \name Construction
+    // -----------------------------------------------------------------------
+
+    /// Open the shared memory segment \p name.
+    ///
+    /// With \ref MapMode::ReadWrite, this process becomes the writer: a new
+    /// segment is created with room for \p capacity elements.
+    ///
+    /// An existing segment of the same name is replaced, even while it has a
+    /// live writer or readers.  It is unlinked rather than reset, so they keep
+    /// valid mappings of it, but they are detached from the name: readers
+    /// opened afterwards never see the old writer's appends, and the old
+    /// readers never see this writer's.  Use one writer per name at a time.
+    ///
+    /// With \ref MapMode::ReadOnly, the segment must have been created by a
+    /// writer.  If its writer is still initializing it, this waits for up to
+    /// \ref openTimeout for the header to be published.
+    ///
+    /// \param name The segment name, starting with a slash.
+    /// \param mode Whether to create the segment for writing, or read it.
+    /// \param capacity The initial capacity of a created segment.
+    ///
+    /// \throws std::system_error If the segment cannot be opened or mapped.
+    /// \throws std::runtime_error If the segment layout does not match, or
+    /// its header is not published within \ref openTimeout.
+    explicit SharedVector(const std::string& name,
+                          MapMode mode = MapMode::ReadOnly,
+                          size_type capacity = 0)
+      : m_mode(mode)
+    {
+        if (mode == MapMode::ReadWrite) {
+            shm_unlink(name.c_str());
+        }
+        m_fd = mode == MapMode::ReadOnly
+                   ? shm_open(name.c_str(), O_RDONLY, 0)
+                   : shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+        if (m_fd < 0) {
+            _ThrowSystemError("Failed to shm_open " + name);
+        }
+
+        try {
+            if (mode == MapMode::ReadWrite) {
+                _Create(capacity);
+            } else {
+                _Open(name);
+            }
+        } catch (...) {
+            _Close();
+            throw;
+        }
+    }
+
+    /// Un-maps the segment.  The segment itself persists until
+    /// \ref unlink is called.
+    ~SharedVector() { _Close(); }
+
+    /// Move constructor.
+    ///
+    /// \param src The source vector to move the mapping from.
+    SharedVector(SharedVector&& src) noexcept
+      : m_fd(std::exchange(src.m_fd, -1))
+      , m_mode(src.m_mode)
+      , m_size(std::exchange(src.m_size, 0))
+      , m_mappedCapacity(std::exchange(src.m_mappedCapacity, 0))
+      , m_header(std::exchange(src.m_header, nullptr))
+    {}
+
+    // Mappings are unique.
+    SharedVector(const SharedVector&) = delete;
+    SharedVector& operator=(const SharedVector&) = delete;
+    SharedVector& operator=(SharedVector&&) = delete;
+
+    /// Remove the shared memory segment \p name.  Processes which have it
+    /// mapped keep their mappings.
+    ///
+    /// \param name The segment name.
+    static void unlink(const std::string& name) { shm_unlink(name.c_str()); }
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access an element.
+    ///
+    /// \param index The index of the element.
+    ///
+    /// \return The element.
+    const value_type& operator[](size_type index) const
+    {
+        return data()[index];
+    }
+
+    /// Access the elements.
+    ///
+    /// \return Pointer to the first element.
+    const value_type* data() const { return _Elements(m_header); }
+
+    /// Get an iterator to the first element.
+    const_iterator begin() const { return data(); }
+
+    /// Get an iterator past the last element.
+    const_iterator end() const { return data() + m_size; }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if the vector had no elements when last refreshed.
+    bool empty() const { return m_size == 0; }
+
+    /// Get the number of elements, as of the last append by this writer, or
+    /// the last \ref refresh by this reader.
+    size_type size() const { return m_size; }
+
+    /// Get the number of elements which fit in the segment.
+    size_type capacity() const
+    {
+        return m_header->capacity.load(std::memory_order_acquire);
+    }
+
+    /// Pick up elements published by the writer since the last call,
+    /// re-mapping the segment if it has grown.
+    ///
+    /// \return The number of elements.
+    size_type refresh()
+    {
+        size_type size = m_header->size.load(std::memory_order_acquire);
+        if (size > m_mappedCapacity) {
+            _Remap(capacity());
+        }
+
+        m_size = size;
+        return m_size;
+    }
+
+    /// Extend the segment to hold at least \p count elements.  Requires
+    /// \ref MapMode::ReadWrite.
+    ///
+    /// \param count The number of elements.
+    void reserve(size_type count)
+    {
+        if (count > m_mappedCapacity) {
+            _Grow(count);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Append and publish an element.  Requires \ref MapMode::ReadWrite.
+    ///
+    /// \param value The element value.
+    void push_back(const value_type& value) { append(&value, 1); }
+
+    /// Append and publish \p count elements, with a single update of the
+    /// published size.  Requires \ref MapMode::ReadWrite.
+    ///
+    /// \param values The elements to append.
+    /// \param count The number of elements.
+    void append(const value_type* values, size_type count)
+    {
+        if (m_mode != MapMode::ReadWrite) {
+            throw std::logic_error(
+                "Cannot append to a read-only SharedVector.");
+        }
+
+        if (m_size + count > m_mappedCapacity) {
+            _Grow(GrowthPolicyT::NextCapacity(
+                m_mappedCapacity, m_size + count, sizeof(value_type)));
+        }
+
+        if (count != 0) {
+            memcpy(_Elements(m_header) + m_size,
+                   values,
+                   sizeof(value_type) * count);
+        }
+        m_size += count;
+        m_header->size.store(m_size, std::memory_order_release);
+    }
+
+private:
+    // Layout of the start of the segment.
+    struct alignas(64) _Header
+    {
+        std::atomic<std::uint32_t> version;
+        std::uint32_t elementSize;
+        std::atomic<std::uint64_t> capacity;
+        std::atomic<std::uint64_t> size;
+    };
+
+    // Offset of the elements from the start of the segment.
+    static constexpr size_type s_elementsOffset =
+        (sizeof(_Header) + alignof(value_type) - 1) / alignof(value_type) *
+        alignof(value_type);
+
+    [[noreturn]] static void _ThrowSystemError(const std::string& message)
+    {
+        throw std::system_error(errno, std::generic_category(), message);
+    }
+
+    // Number of bytes of segment for \p count elements.
+    static size_type _SegmentBytes(size_type count)
+    {
+        return s_elementsOffset + sizeof(value_type) * count;
+    }
+
+    // Get the elements following \p header.
+    static value_type* _Elements(_Header* header)
+    {
+        return reinterpret_cast<value_type*>(
+            reinterpret_cast<std::byte*>(header) + s_elementsOffset);
+    }
+
+    // Size a new segment, and initialize its header.  The version is
+    // published last, marking the header as complete.
+    void _Create(size_type capacity)
+    {
+        if (ftruncate(m_fd, _SegmentBytes(capacity)) < 0) {
+            _ThrowSystemError("Failed to ftruncate");
+        }
+
+        _Remap(capacity);
+        m_header->elementSize = sizeof(value_type);
+        m_header->size.store(0, std::memory_order_relaxed);
+        m_header->capacity.store(capacity, std::memory_order_relaxed);
+        m_header->version.store(version, std::memory_order_release);
+    }
+
+    // Map an existing segment, and validate its header.
+    void _Open(const std::string& name)
+    {
+        // The segment is empty, then zero-filled, until its writer has sized
+        // it and written the header.
+        std::chrono::steady_clock::time_point deadline =
+            std::chrono::steady_clock::now() + openTimeout;
+        std::uint32_t published = 0;
+        while ((published = _PublishedVersion()) == 0) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                throw std::runtime_error(name + " was not initialized.");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if (published != version ||
+            m_header->elementSize != sizeof(value_type)) {
+            throw std::runtime_error(name + " has an incompatible layout.");
+        }
+
+        refresh();
+    }
+
+    // Map the header once the segment is large enough to hold it, and load
+    // its version.  Returns 0 while the header is not published.
+    std::uint32_t _PublishedVersion()
+    {
+        if (m_header == nullptr) {
+            struct stat status;
+            if (fstat(m_fd, &status) < 0) {
+                _ThrowSystemError("Failed to fstat");
+            }
+            if (size_type(status.st_size) < _SegmentBytes(0)) {
+                return 0;
+            }
+            _Remap(0);
+        }
+
+        return m_header->version.load(std::memory_order_acquire);
+    }
+
+    // Map (or re-map) the segment to hold \p capacity elements.
+    void _Remap(size_type capacity)
+    {
+        void* ptr;
+        if (m_header == nullptr) {
+            int protection = m_mode == MapMode::ReadOnly
+                                 ? PROT_READ
+                                 : PROT_READ | PROT_WRITE;
+            ptr = mmap(nullptr,
+                       _SegmentBytes(capacity),
+                       protection,
+                       MAP_SHARED,
+                       m_fd,
+                       0);
+        } else {
+            ptr = mremap(m_header,
+                         _SegmentBytes(m_mappedCapacity),
+                         _SegmentBytes(capacity),
+                         MREMAP_MAYMOVE);
+        }
+
+        if (ptr == MAP_FAILED) {
+            _ThrowSystemError("Failed to map shared memory");
+        }
+
+        m_header = static_cast<_Header*>(ptr);
+        m_mappedCapacity = capacity;
+    }
+
+    // Extend the segment to hold \p count elements.
+    void _Grow(size_type count)
+    {
+        if (m_mode != MapMode::ReadWrite) {
+            throw std::logic_error("Cannot grow a read-only SharedVector.");
+        }
+
+        if (ftruncate(m_fd, _SegmentBytes(count)) < 0) {
+            _ThrowSystemError("Failed to ftruncate");
+        }
+
+        _Remap(count);
+        m_header->capacity.store(count, std::memory_order_release);
+    }
+
+    // Un-map and close the segment.
+    void _Close()
+    {
+        if (m_header != nullptr) {
+            munmap(m_header, _SegmentBytes(m_mappedCapacity));
+            m_header = nullptr;
+        }
+
+        if (m_fd >= 0) {
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    // File descriptor of the shared memory segment.
+    int m_fd = -1;
+
+    // Whether this process is the writer.
+    MapMode m_mode = MapMode::ReadOnly;
+
+    // Number of elements visible to this process.
+    size_type m_size = 0;
+
+    // Number of elements covered by this process' mapping.
+    size_type m_mappedCapacity = 0;
+
+    // Pointer to the mapping, which starts with the header.
+    _Header* m_header = nullptr;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "allocator.h"
+#include "vector.h"
+
+/// \class SmallVector
+///
+/// A \ref Vector which stores up to \p InlineCapacityV elements within the
+/// object itself, only allocating from \p FallbackAllocatorT once it grows
+/// beyond that.
+///
+/// The first allocation which fits in the inline storage is served from it,
+/// and reports a capacity of \p InlineCapacityV.  Moving or swapping a
+/// SmallVector whose elements are inline moves the elements individually.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam InlineCapacityV The number of elements stored inline.
+/// \tparam FallbackAllocatorT The allocator used once the inline storage is
+/// exceeded.
+template<typename ValueT,
+         std::size_t InlineCapacityV = 16,
+         typename FallbackAllocatorT = MallocAllocator<ValueT>>
+class SmallVector
+  : public Vector<ValueT,
+                  InlineAllocator<ValueT, InlineCapacityV, FallbackAllocatorT>>
+{
+    using _Base =
+        Vector<ValueT,
+               InlineAllocator<ValueT, InlineCapacityV, FallbackAllocatorT>>;
+
+public:
+    using _Base::_Base;
+    using _Base::operator=;
+
+    /// Constructs an empty vector.
+    ///
+    /// \param location The call site, for the statistics policy.
+    SmallVector(
+        std::source_location location = std::source_location::current())
+      : _Base(location)
+    {}
+
+    /// Get the number of elements stored inline.
+    static constexpr std::size_t inline_capacity() { return InlineCapacityV; }
+
+    /// Check if the elements are currently stored inline.
+    ///
+    /// \retval true If the elements live in the inline storage.
+    /// \retval false If no storage is allocated, or the elements have spilled
+    /// to the fallback allocator.
+    bool is_inline() const
+    {
+        return this->_GetAllocator().is_inline(this->data());
+    }
+};
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+/// \class SoALayout
+///
+/// Describes how \p RecordT is split into columns by \ref SoAVector.
+/// Specializations must provide a \p members tuple, of pointers to each data
+/// member of \p RecordT to store, for example:
+///
+/// \code
+/// template<>
+/// struct SoALayout<Vec3f>
+/// {
+///     static constexpr auto members =
+///         std::make_tuple(&Vec3f::x, &Vec3f::y, &Vec3f::z);
+/// };
+/// \endcode
+///
+/// \p RecordT must be default constructible, and is re-assembled from its
+/// columns by assigning each described member.
+///
+/// \tparam RecordT The record type.
+template<typename RecordT>
+struct SoALayout;
+
+/// \class SoAVector
+///
+/// A dynamically re-sizable array of \p RecordT, stored as a
+/// structure-of-arrays: each member described by \ref SoALayout lives in its
+/// own contiguous column, aligned to (at least) a cache line.
+///
+/// Kernels touching a subset of the members only stream those columns
+/// through the cache, and may process each column as a \p std::span with
+/// aligned SIMD loads (see \ref column).  Element access returns proxy
+/// references, which convert to and from \p RecordT.
+///
+/// \tparam RecordT The record type.
+template<typename RecordT>
+class SoAVector
+{
+    // Member pointers describing each column.
+    static constexpr auto s_members = SoALayout<RecordT>::members;
+
+    // Number of columns.
+    static constexpr std::size_t s_numColumns =
+        std::tuple_size_v<std::remove_cv_t<decltype(s_members)>>;
+
+    // Get the member type pointed to by \p MemberPtrT.
+    template<typename MemberPtrT>
+    struct _MemberType;
+
+    template<typename ClassT, typename FieldT>
+    struct _MemberType<FieldT ClassT::*>
+    {
+        using type = FieldT;
+    };
+
+    // Type of the field of column \p IndexV.
+    template<std::size_t IndexV>
+    using _FieldT = typename _MemberType<std::remove_cv_t<
+        std::tuple_element_t<IndexV,
+                             std::remove_cv_t<decltype(s_members)>>>>::type;
+
+    // Storage of a single column.
+    template<typename FieldT>
+    using _ColumnT =
+        AlignedVector<FieldT, std::max<std::size_t>(64, alignof(FieldT))>;
+
+    // Storage of all columns.
+    template<typename IndicesT>
+    struct _Columns;
+
+    template<std::size_t... IndicesV>
+    struct _Columns<std::index_sequence<IndicesV...>>
+    {
+        using type = std::tuple<_ColumnT<_FieldT<IndicesV>>...>;
+    };
+
+    using _ColumnsT =
+        typename _Columns<std::make_index_sequence<s_numColumns>>::type;
+
+    // Proxy reference to the record at an index, via \p VectorT (which may
+    // be const-qualified).
+    template<typename VectorT>
+    class _Reference
+    {
+    public:
+        _Reference(VectorT* vector, std::size_t index)
+          : m_vector(vector)
+          , m_index(index)
+        {}
+
+        /// Access the member \p MemberV of the referenced record.
+        template<auto MemberV>
+        auto& get() const
+        {
+            return m_vector->template column<MemberV>()[m_index];
+        }
+
+        /// Re-assemble the referenced record.
+        operator RecordT() const { return m_vector->_Load(m_index); }
+
+        /// Assign each member of the referenced record from \p record.
+        const _Reference& operator=(const RecordT& record) const
+            requires(!std::is_const_v<VectorT>)
+        {
+            m_vector->_Store(m_index, record);
+            return *this;
+        }
+
+        /// Assign the record referenced by \p other to the referenced record.
+        const _Reference& operator=(const _Reference& other) const
+            requires(!std::is_const_v<VectorT>)
+        {
+            return operator=(RecordT(other));
+        }
+
+    private:
+        VectorT* m_vector = nullptr;
+        std::size_t m_index = 0;
+    };
+
+public:
+    /// \typedef value_type
+    ///
+    /// The record type.
+    using value_type = RecordT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// \typedef reference
+    ///
+    /// Proxy reference to a record, in a writable manner.
+    using reference = _Reference<SoAVector>;
+
+    /// \typedef const_reference
+    ///
+    /// Proxy reference to a record, in a read-only manner.
+    using const_reference = _Reference<const SoAVector>;
+
+    // -----------------------------------------------------------------------
+    /// \name Element access
+    // -----------------------------------------------------------------------
+
+    /// Access the record at \p index, in a read-only fashion.
+    ///
+    /// \param index The index of the record.
+    ///
+    /// \return Proxy reference to the record.
+    const_reference operator[](size_type index) const
+    {
+        return const_reference(this, index);
+    }
+
+    /// Access the record at \p index, in a mutable fashion.
+    ///
+    /// \param index The index of the record.
+    ///
+    /// \return Proxy reference to the record.
+    reference operator[](size_type index) { return reference(this, index); }
+
+    /// Access the column storing \p MemberV of every record, in a read-only
+    /// fashion.
+    ///
+    /// \tparam MemberV Pointer to the member, as described by
+    /// \ref SoALayout.
+    ///
+    /// \return Span over the column, whose data is aligned to at least 64
+    /// bytes.
+    template<auto MemberV>
+    auto column() const
+    {
+        const auto& columnVector = std::get<_IndexOf<MemberV>()>(m_columns);
+        return std::span(columnVector.data(), columnVector.size());
+    }
+
+    /// Access the column storing \p MemberV of every record, in a mutable
+    /// fashion.
+    ///
+    /// \tparam MemberV Pointer to the member, as described by
+    /// \ref SoALayout.
+    ///
+    /// \return Span over the column, whose data is aligned to at least 64
+    /// bytes.
+    template<auto MemberV>
+    auto column()
+    {
+        auto& columnVector = std::get<_IndexOf<MemberV>()>(m_columns);
+        return std::span(columnVector.data(), columnVector.size());
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Capacity
+    // -----------------------------------------------------------------------
+
+    /// Check if the container has no records.
+    bool empty() const { return size() == 0; }
+
+    /// Get the number of records.
+    size_type size() const { return std::get<0>(m_columns).size(); }
+
+    /// Get the number of records which can be contained in the current
+    /// allocations.
+    size_type capacity() const { return std::get<0>(m_columns).capacity(); }
+
+    /// Reserve storage for at least \p count records in every column.
+    ///
+    /// \param count The number of records.
+    void reserve(size_type count)
+    {
+        _ForEachColumn(
+            [&](auto& columnVector) { columnVector.reserve(count); });
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Modifiers
+    // -----------------------------------------------------------------------
+
+    /// Clear all records.
+    void clear()
+    {
+        _ForEachColumn([](auto& columnVector) { columnVector.clear(); });
+    }
+
+    /// Resize to contain \p count records, appending value-initialized
+    /// members when increasing in size.
+    ///
+    /// \param count The number of records.
+    void resize(size_type count)
+    {
+        _ForEachColumn([&](auto& columnVector) { columnVector.resize(count); });
+    }
+
+    /// Resize to contain \p count records, appending default-initialized
+    /// members when increasing in size.  See \ref DefaultInit.
+    ///
+    /// \param count The number of records.
+    void resize(size_type count, DefaultInitT)
+    {
+        _ForEachColumn([&](auto& columnVector) {
+            columnVector.resize(count, DefaultInit);
+        });
+    }
+
+    /// Append \p record, splitting its members across the columns.
+    ///
+    /// \param record The record.
+    void push_back(const RecordT& record)
+    {
+        _ForEachIndex([&]<std::size_t IndexV>() {
+            std::get<IndexV>(m_columns).push_back(
+                record.*std::get<IndexV>(s_members));
+        });
+    }
+
+    /// Remove the last record.
+    void pop_back()
+    {
+        _ForEachColumn([](auto& columnVector) { columnVector.pop_back(); });
+    }
+
+private:
+    // Get the index of the column storing \p MemberV.
+    template<auto MemberV>
+    static constexpr std::size_t _IndexOf()
+    {
+        constexpr std::size_t index =
+            []<std::size_t... IndicesV>(std::index_sequence<IndicesV...>) {
+                std::size_t result = s_numColumns;
+                ((_IsSameMember(MemberV, std::get<IndicesV>(s_members))
+                      ? (result = IndicesV)
+                      : 0),
+                 ...);
+                return result;
+            }(std::make_index_sequence<s_numColumns>());
+        static_assert(index < s_numColumns,
+                      "Member is not described by SoALayout.");
+        return index;
+    }
+
+    // Check if member pointers \p a and \p b point to the same member.
+    template<typename MemberPtrA, typename MemberPtrB>
+    static constexpr bool _IsSameMember(MemberPtrA a, MemberPtrB b)
+    {
+        if constexpr (std::is_same_v<MemberPtrA, MemberPtrB>) {
+            return a == b;
+        } else {
+            return false;
+        }
+    }
+
+    // Invoke \p fn with each column index as a template argument.
+    template<typename FnT>
+    static void _ForEachIndex(FnT&& fn)
+    {
+        [&]<std::size_t... IndicesV>(std::index_sequence<IndicesV...>) {
+            (fn.template operator()<IndicesV>(), ...);
+        }(std::make_index_sequence<s_numColumns>());
+    }
+
+    // Invoke \p fn with each column.
+    template<typename FnT>
+    void _ForEachColumn(FnT&& fn)
+    {
+        std::apply([&](auto&... columnVectors) { (fn(columnVectors), ...); },
+                   m_columns);
+    }
+
+    // Re-assemble the record at \p index from its members.
+    RecordT _Load(size_type index) const
+    {
+        RecordT record{};
+        _ForEachIndex([&]<std::size_t IndexV>() {
+            record.*std::get<IndexV>(s_members) =
+                std::get<IndexV>(m_columns)[index];
+        });
+        return record;
+    }
+
+    // Store each member of \p record at \p index.
+    void _Store(size_type index, const RecordT& record)
+    {
+        _ForEachIndex([&]<std::size_t IndexV>() {
+            std::get<IndexV>(m_columns)[index] =
+                record.*std::get<IndexV>(s_members);
+        });
+    }
+
+    // One vector per member.
+    _ColumnsT m_columns;
+};
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "allocator.h"
+
+/// \class SpscRing
+///
+/// A bounded, lock-free queue between exactly one producer thread and one
+/// consumer thread.
+///
+/// Elements live in a ring buffer whose capacity is a power of two.  The
+/// producer owns the tail index and the consumer owns the head index, each
+/// on its own cache line.  Each side also caches the last index it read of
+/// the other side, so that it only touches the other side's cache line when
+/// the ring appears full (or empty), rather than on every operation.
+///
+/// The batch operations publish any number of elements with a single store.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam AllocatorT Allocates the ring buffer.
+template<typename ValueT, typename AllocatorT = MallocAllocator<ValueT>>
+class SpscRing
+{
+public:
+    /// \typedef value_type
+    ///
+    /// The value type of each element.
+    using value_type = ValueT;
+
+    /// \typedef size_type
+    ///
+    /// The value type of the container size.
+    using size_type = std::size_t;
+
+    /// Constructs an empty ring.
+    ///
+    /// \param capacity The minimum number of elements the ring can hold,
+    /// rounded up to a power of two.
+    /// \param allocator The allocator instance.
+    explicit SpscRing(size_type capacity,
+                      const AllocatorT& allocator = AllocatorT())
+      : m_allocator(allocator)
+      , m_capacity(std::bit_ceil(std::max<size_type>(capacity, 1)))
+      , m_buffer(m_allocator.allocate(m_capacity))
+    {}
+
+    /// Destroys the remaining elements, and frees the ring buffer.
+    ~SpscRing()
+    {
+        size_type tail = m_tail.load(std::memory_order_acquire);
+        for (size_type head = m_head.load(std::memory_order_relaxed);
+             head != tail;
+             ++head) {
+            std::destroy_at(_Slot(head));
+        }
+        m_allocator.deallocate(m_buffer, m_capacity);
+    }
+
+    // Each side holds the ring by reference.
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /// Get the number of elements the ring can hold.
+    size_type capacity() const { return m_capacity; }
+
+    /// Get the number of elements in the ring.  Exact only when neither side
+    /// is operating.
+    size_type size_approx() const
+    {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Producer
+    // -----------------------------------------------------------------------
+
+    /// Append an element constructed in-place with \p args, if there is
+    /// room.  Only the producer may call this.
+    ///
+    /// \param args The constructor arguments.
+    ///
+    /// \return Whether the element was appended.
+    template<typename... ArgsT>
+    bool try_emplace(ArgsT&&... args)
+    {
+        size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (_FreeSlots(tail, 1) == 0) {
+            return false;
+        }
+
+        ::new (static_cast<void*>(_Slot(tail)))
+            value_type(std::forward<ArgsT>(args)...);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Append a copy of \p value, if there is room.  Only the producer may
+    /// call this.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Whether the element was appended.
+    bool try_push(const value_type& value) { return try_emplace(value); }
+
+    /// Append \p value by move, if there is room.  Only the producer may
+    /// call this.
+    ///
+    /// \param value The element value.
+    ///
+    /// \return Whether the element was appended.
+    bool try_push(value_type&& value) { return try_emplace(std::move(value)); }
+
+    /// Append copies of as many of the \p count elements at \p values as
+    /// there is room for, publishing them at once.  Only the producer may
+    /// call this.  Should a copy throw, the elements before it are published.
+    ///
+    /// \param values The elements.
+    /// \param count The number of elements.
+    ///
+    /// \return The number of elements appended, from the front.
+    size_type push_batch(const value_type* values, size_type count)
+    {
+        size_type tail = m_tail.load(std::memory_order_relaxed);
+        count = std::min(count, _FreeSlots(tail, count));
+        size_type index = 0;
+        try {
+            for (; index < count; ++index) {
+                ::new (static_cast<void*>(_Slot(tail + index)))
+                    value_type(values[index]);
+            }
+        } catch (...) {
+            // Publish the elements constructed before the failure.
+            m_tail.store(tail + index, std::memory_order_release);
+            throw;
+        }
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // -----------------------------------------------------------------------
+    /// \name Consumer
+    // -----------------------------------------------------------------------
+
+    /// Remove the front element into \p value, if there is one.  Only the
+    /// consumer may call this.
+    ///
+    /// \param value Receives the element.
+    ///
+    /// \return Whether an element was removed.
+    bool try_pop(value_type& value)
+    {
+        size_type head = m_head.load(std::memory_order_relaxed);
+        if (_FilledSlots(head, 1) == 0) {
+            return false;
+        }
+
+        value_type* slot = _Slot(head);
+        value = std::move(*slot);
+        std::destroy_at(slot);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Remove up to \p maxCount front elements into \p values, releasing
+    /// their slots at once.  Only the consumer may call this.  Should a move
+    /// throw, the elements before it are removed, and the rest kept.
+    ///
+    /// \param values Receives the elements.
+    /// \param maxCount The maximum number of elements to remove.
+    ///
+    /// \return The number of elements removed.
+    size_type pop_batch(value_type* values, size_type maxCount)
+    {
+        size_type head = m_head.load(std::memory_order_relaxed);
+        size_type count = std::min(maxCount, _FilledSlots(head, maxCount));
+        size_type index = 0;
+        try {
+            for (; index < count; ++index) {
+                value_type* slot = _Slot(head + index);
+                values[index] = std::move(*slot);
+                std::destroy_at(slot);
+            }
+        } catch (...) {
+            // Release the slots emptied before the failure, leaving the
+            // element which failed to move at the front.
+            m_head.store(head + index, std::memory_order_release);
+            throw;
+        }
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    static constexpr size_type s_cacheLineSize = 64;
+
+    value_type* _Slot(size_type index) const
+    {
+        return m_buffer + (index & (m_capacity - 1));
+    }
+
+    // Number of free slots after \p tail, re-reading the head only if the
+    // cached head leaves fewer than \p wanted.
+    size_type _FreeSlots(size_type tail, size_type wanted)
+    {
+        size_type free = m_capacity - (tail - m_cachedHead);
+        if (free < wanted) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            free = m_capacity - (tail - m_cachedHead);
+        }
+        return free;
+    }
+
+    // Number of filled slots from \p head, re-reading the tail only if the
+    // cached tail leaves fewer than \p wanted.
+    size_type _FilledSlots(size_type head, size_type wanted)
+    {
+        size_type filled = m_cachedTail - head;
+        if (filled < wanted) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            filled = m_cachedTail - head;
+        }
+        return filled;
+    }
+
+    // Read-only after construction, and shared by both sides.
+    [[no_unique_address]] AllocatorT m_allocator;
+    const size_type m_capacity;
+    value_type* const m_buffer;
+
+    // Consumer side: the index of the next element to pop, and its cache of
+    // the tail.  The indices increase without wrapping.
+    alignas(s_cacheLineSize) std::atomic<size_type> m_head = 0;
+    size_type m_cachedTail = 0;
+
+    // Producer side: the index of the next slot to push to, and its cache of
+    // the head.
+    alignas(s_cacheLineSize) std::atomic<size_type> m_tail = 0;
+    size_type m_cachedHead = 0;
+};
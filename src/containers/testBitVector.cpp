@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <vector>
+
+#include "bitVector.h"
+
+// Make \p count random bits, each set with probability \p density, as both a
+// BitVector and a std::vector<bool>.
+static std::pair<BitVector, std::vector<bool>>
+_MakeRandomBits(size_t count, double density, unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::bernoulli_distribution distribution(density);
+    BitVector bits;
+    std::vector<bool> reference;
+    for (size_t index = 0; index < count; ++index) {
+        bool value = distribution(engine);
+        bits.push_back(value);
+        reference.push_back(value);
+    }
+    return { std::move(bits), std::move(reference) };
+}
+
+// Check that \p bits and \p reference hold the same bits.
+static void _CheckEqual(const BitVector& bits,
+                        const std::vector<bool>& reference)
+{
+    REQUIRE(bits.size() == reference.size());
+    for (size_t index = 0; index < reference.size(); ++index) {
+        REQUIRE(bits[index] == reference[index]);
+    }
+}
+
+TEST_CASE("BitVector_Access")
+{
+    BitVector bits(130);
+    CHECK(bits.size() == 130);
+    CHECK(bits.word_count() == 3);
+    CHECK(bits.none());
+    CHECK(bits.find_first() == BitVector::npos);
+    CHECK_THROWS_AS(bits.at(130), std::out_of_range);
+
+    bits.set(0);
+    bits.set(64);
+    bits.set(129, true);
+    bits.flip(65);
+    CHECK(bits.count() == 4);
+    bits.reset(64);
+    bits.set(65, false);
+    CHECK(bits.count() == 2);
+    CHECK(bits.test(0));
+    CHECK(bits.at(129));
+
+    // Bits past the size stay zero.
+    bits.set();
+    CHECK(bits.all());
+    CHECK(bits.count() == 130);
+    CHECK(bits.words()[2] == 0b11);
+    bits.flip();
+    CHECK(bits.none());
+
+    bits.resize(200, true);
+    CHECK(bits.count() == 70);
+    CHECK(bits.find_first() == 130);
+    bits.resize(150);
+    CHECK(bits.count() == 20);
+    bits.resize(300);
+    CHECK(bits.count() == 20);
+
+    BitVector empty;
+    CHECK(empty.find_first() == BitVector::npos);
+    CHECK(empty.all());
+}
+
+TEST_CASE("BitVector_BitwiseOperations")
+{
+    constexpr size_t numBits = 10'007;
+    auto [lhs, lhsRef] = _MakeRandomBits(numBits, 0.5, 1);
+    auto [rhs, rhsRef] = _MakeRandomBits(numBits, 0.3, 2);
+
+    std::vector<bool> andRef(numBits), orRef(numBits), xorRef(numBits),
+        notRef(numBits);
+    for (size_t index = 0; index < numBits; ++index) {
+        andRef[index] = lhsRef[index] && rhsRef[index];
+        orRef[index] = lhsRef[index] || rhsRef[index];
+        xorRef[index] = lhsRef[index] != rhsRef[index];
+        notRef[index] = !lhsRef[index];
+    }
+
+    _CheckEqual(lhs & rhs, andRef);
+    _CheckEqual(lhs | rhs, orRef);
+    _CheckEqual(lhs ^ rhs, xorRef);
+    _CheckEqual(~lhs, notRef);
+    CHECK((lhs ^ lhs).none());
+    CHECK((lhs | ~lhs).all());
+    CHECK((lhs & rhs) == (rhs & lhs));
+
+    BitVector shorter(numBits - 1);
+    CHECK_THROWS_AS(lhs &= shorter, std::invalid_argument);
+}
+
+TEST_CASE("BitVector_Search")
+{
+    for (double density : { 0.001, 0.1, 0.9 }) {
+        auto [bits, reference] = _MakeRandomBits(50'000, density, 3);
+
+        size_t expectedCount = 0;
+        for (bool value : reference) {
+            expectedCount += value;
+        }
+        CHECK(bits.count() == expectedCount);
+
+        // find_first and find_next visit each set bit in order.
+        std::vector<size_t> positions;
+        for (size_t index = bits.find_first(); index != BitVector::npos;
+             index = bits.find_next(index)) {
+            positions.push_back(index);
+        }
+        std::vector<size_t> expectedPositions;
+        for (size_t index = 0; index < reference.size(); ++index) {
+            if (reference[index]) {
+                expectedPositions.push_back(index);
+            }
+        }
+        CHECK(positions == expectedPositions);
+
+        // rank and select are inverses over the set bits.
+        bits.build_rank_index();
+        size_t rank = 0;
+        for (size_t index = 0; index <= reference.size(); ++index) {
+            REQUIRE(bits.rank(index) == rank);
+            if (index < reference.size() && reference[index]) {
+                REQUIRE(bits.select(rank) == index);
+                rank++;
+            }
+        }
+        CHECK(bits.select(expectedCount) == BitVector::npos);
+    }
+}
@@ -0,0 +1,192 @@
+#include <catch2/catch.hpp>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+
+#include "concurrentVector.h"
+#include "testUtils.h"
+#include "vector.h"
+
+// Check that \p vec holds each index in [0, \p count) exactly once.
+template<typename VectorT>
+static void _CheckPermutation(const VectorT& vec, size_t count)
+{
+    REQUIRE(vec.size() == count);
+    Vector<size_t> indices;
+    for (const auto& value : vec) {
+        indices.push_back(_GetIndex(value));
+    }
+    std::sort(indices.begin(), indices.end());
+    for (size_t index = 0; index < count; ++index) {
+        REQUIRE(indices[index] == index);
+    }
+}
+
+TEST_CASE("ConcurrentVector_Iterator")
+{
+    using VectorT = ConcurrentVector<int>;
+    STATIC_REQUIRE(std::random_access_iterator<VectorT::iterator>);
+    STATIC_REQUIRE(std::random_access_iterator<VectorT::const_iterator>);
+
+    VectorT vec;
+    CHECK(vec.empty());
+    CHECK(vec.begin() == vec.end());
+    for (int i = 0; i < 10'000; ++i) {
+        vec.push_back(i);
+    }
+
+    VectorT::const_iterator it = vec.begin();
+    CHECK(it[9'999] == 9'999);
+    CHECK(vec.end() - vec.begin() == 10'000);
+    CHECK(*(vec.begin() + 5'000) == 5'000);
+    CHECK(std::distance(vec.begin(), std::find(vec.begin(), vec.end(), 42)) ==
+          42);
+    CHECK_THROWS_AS(vec.at(10'000), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("ConcurrentVector_push_back",
+                   "[template]",
+                   int,
+                   std::string)
+{
+    ConcurrentVector<TestType> vec;
+    TestType* first = &*vec.push_back(_MakeValue<TestType>(0));
+    for (size_t index = 1; index < 100'000; ++index) {
+        auto it = vec.push_back(_MakeValue<TestType>(index));
+        REQUIRE(*it == _MakeValue<TestType>(index));
+    }
+
+    // Growth never moves elements.
+    CHECK(&vec[0] == first);
+    CHECK(vec.capacity() >= vec.size());
+    for (size_t index = 0; index < vec.size(); ++index) {
+        REQUIRE(vec[index] == _MakeValue<TestType>(index));
+    }
+
+    ConcurrentVector<TestType> moved(std::move(vec));
+    CHECK(vec.empty());
+    CHECK(moved.size() == 100'000);
+    CHECK(&moved[0] == first);
+
+    moved.clear();
+    CHECK(moved.empty());
+    CHECK(moved.capacity() >= 100'000);
+}
+
+TEMPLATE_TEST_CASE("ConcurrentVector_ConcurrentPushBack",
+                   "[template]",
+                   int,
+                   std::string)
+{
+    constexpr size_t numElements = 200'000;
+
+    SECTION("parallel_for")
+    {
+        ConcurrentVector<TestType> vec;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, numElements),
+                          [&](const tbb::blocked_range<size_t>& range) {
+                              for (size_t index = range.begin();
+                                   index < range.end();
+                                   ++index) {
+                                  vec.push_back(_MakeValue<TestType>(index));
+                              }
+                          });
+        _CheckPermutation(vec, numElements);
+    }
+
+    SECTION("threads")
+    {
+        // Dedicated threads interleave even on a single core.
+        constexpr size_t numThreads = 4;
+        ConcurrentVector<TestType> vec;
+        Vector<std::thread> threads;
+        for (size_t thread = 0; thread < numThreads; ++thread) {
+            threads.emplace_back([&, thread] {
+                for (size_t index = thread; index < numElements;
+                     index += numThreads) {
+                    vec.emplace_back(_MakeValue<TestType>(index));
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        _CheckPermutation(vec, numElements);
+    }
+}
+
+TEST_CASE("ConcurrentVector_grow_by")
+{
+    constexpr size_t numBlocks = 1000;
+    constexpr size_t blockSize = 257;
+    ConcurrentVector<size_t> vec;
+    vec.reserve(10);
+    CHECK(vec.capacity() >= 10);
+
+    tbb::parallel_for(size_t(0), numBlocks, [&](size_t block) {
+        auto first = vec.grow_by(blockSize, block);
+        *first = block;
+    });
+
+    // Each block is contiguous.
+    REQUIRE(vec.size() == numBlocks * blockSize);
+    Vector<size_t> counts(numBlocks);
+    for (size_t index = 0; index < vec.size(); index += blockSize) {
+        size_t block = vec[index];
+        REQUIRE(block < numBlocks);
+        for (size_t offset = 0; offset < blockSize; ++offset) {
+            REQUIRE(vec[index + offset] == block);
+        }
+        counts[block]++;
+    }
+    CHECK(std::all_of(
+        counts.begin(), counts.end(), [](size_t count) { return count == 1; }));
+
+    auto first = vec.grow_by(3);
+    CHECK(first - vec.begin() == numBlocks * blockSize);
+    CHECK(std::all_of(
+        first, vec.end(), [](size_t value) { return value == 0; }));
+}
+
+// MallocAllocator which throws std::bad_alloc once s_fail is set.
+template<typename ValueT>
+class FailingAllocator : public MallocAllocator<ValueT>
+{
+public:
+    static inline bool s_fail = false;
+
+    ValueT* allocate(std::size_t count)
+    {
+        if (s_fail) {
+            throw std::bad_alloc();
+        }
+        return MallocAllocator<ValueT>::allocate(count);
+    }
+};
+
+TEST_CASE("ConcurrentVector_AllocationFailure")
+{
+    using AllocatorT = FailingAllocator<std::string>;
+    ConcurrentVector<std::string, AllocatorT> vec;
+    vec.push_back("foo");
+    size_t capacity = vec.capacity();
+    vec.grow_by(capacity - 1, "bar");
+
+    // A failed segment allocation claims no index, so that clearing and
+    // destroying the vector only touch constructed elements.
+    AllocatorT::s_fail = true;
+    CHECK_THROWS_AS(vec.push_back("baz"), std::bad_alloc);
+    CHECK_THROWS_AS(vec.grow_by(3), std::bad_alloc);
+    AllocatorT::s_fail = false;
+    CHECK(vec.size() == capacity);
+
+    vec.push_back("baz");
+    CHECK(vec.size() == capacity + 1);
+    CHECK(vec[capacity] == "baz");
+    vec.clear();
+    CHECK(vec.empty());
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+#include <tbb/parallel_for.h>
+
+#include <string>
+#include <thread>
+
+#include "cowVector.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEST_CASE("CowVector_Empty")
+{
+    CowVector<int> vec;
+    CHECK(vec.empty());
+    CHECK(vec.size() == 0);
+    CHECK(vec.use_count() == 0);
+    CHECK(vec.begin() == vec.end());
+    CHECK_THROWS_AS(vec.at(0), std::out_of_range);
+
+    // Copying an empty vector does not allocate.
+    CowVector<int> copy(vec);
+    CHECK(copy.use_count() == 0);
+    CHECK(!copy.shares_with(vec));
+}
+
+TEMPLATE_TEST_CASE("CowVector_CopyOnWrite",
+                   "[template]",
+                   int,
+                   std::string)
+{
+    CowVector<TestType> vec(3, TestType());
+    vec.mutable_at(1) = _MakeValue<TestType>(1);
+    const TestType* buffer = vec.data();
+
+    // Copies share the buffer.
+    CowVector<TestType> snapshot(vec);
+    CHECK(snapshot.shares_with(vec));
+    CHECK(vec.use_count() == 2);
+    CHECK(snapshot.data() == buffer);
+
+    // The first mutation copies the buffer, leaving the snapshot intact.
+    vec.push_back(_MakeValue<TestType>(1));
+    CHECK(!snapshot.shares_with(vec));
+    CHECK(vec.use_count() == 1);
+    CHECK(snapshot.use_count() == 1);
+    CHECK(snapshot.data() == buffer);
+    CHECK(snapshot.size() == 3);
+    CHECK(vec.size() == 4);
+    CHECK(snapshot[1] == _MakeValue<TestType>(1));
+    CHECK(vec[3] == _MakeValue<TestType>(1));
+
+    // Later mutations of the sole owner are in-place.
+    const TestType* detached = vec.data();
+    vec.mutable_at(0) = _MakeValue<TestType>(1);
+    CHECK(vec.data() == detached);
+    CHECK(snapshot[0] == TestType());
+
+    // Clearing a shared vector releases it instead of copying.
+    CowVector<TestType> other = snapshot;
+    other.clear();
+    CHECK(other.empty());
+    CHECK(other.use_count() == 0);
+    CHECK(snapshot.size() == 3);
+
+    CowVector<TestType> moved(std::move(snapshot));
+    CHECK(snapshot.empty());
+    CHECK(moved.data() == buffer);
+}
+
+TEST_CASE("CowVector_Assignment")
+{
+    CowVector<int> vec{ 1, 2, 3 };
+    CowVector<int> copy;
+    copy = vec;
+    CHECK(copy.shares_with(vec));
+
+    copy = copy;
+    CHECK(vec.use_count() == 2);
+
+    copy = CowVector<int>(Vector<int>{ 4, 5 });
+    CHECK(vec.use_count() == 1);
+    CHECK(copy.size() == 2);
+    CHECK(copy.back() == 5);
+
+    copy.mutable_vector().erase_if([](int value) { return value == 4; });
+    CHECK(copy.size() == 1);
+    CHECK(copy.front() == 5);
+}
+
+TEST_CASE("CowVector_ConcurrentSnapshots")
+{
+    // One thread mutates and publishes snapshots, while others read them.
+    constexpr int numSnapshots = 200;
+    CowVector<int> vec(1000);
+    Vector<CowVector<int>> snapshots(numSnapshots);
+
+    for (int snapshot = 0; snapshot < numSnapshots; ++snapshot) {
+        snapshots[snapshot] = vec;
+        for (int index = 0; index < 1000; ++index) {
+            vec.mutable_at(index) = snapshot + 1;
+        }
+    }
+
+    tbb::parallel_for(0, numSnapshots, [&](int snapshot) {
+        CowVector<int> reader = snapshots[snapshot];
+        for (int value : reader) {
+            REQUIRE(value == snapshot);
+        }
+    });
+
+    // Threads share and release one buffer at once.
+    CowVector<int> shared = vec;
+    Vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10'000; ++i) {
+                CowVector<int> copy = shared;
+                REQUIRE(copy[0] == numSnapshots);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(shared.use_count() == 2);
+}
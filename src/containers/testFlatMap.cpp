@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <random>
+#include <string>
+
+#include "flatMap.h"
+#include "vector.h"
+
+// Make \p count pairs of distinct random keys, mapped to their order of
+// generation.
+static Vector<std::pair<int, int>> _MakeRandomPairs(size_t count,
+                                                    unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::map<int, int> unique;
+    while (unique.size() < count) {
+        unique.emplace(int(engine() >> 1), int(unique.size()));
+    }
+
+    Vector<std::pair<int, int>> pairs(unique.begin(), unique.end());
+    std::shuffle(pairs.begin(), pairs.end(), engine);
+    return pairs;
+}
+
+TEMPLATE_TEST_CASE_SIG("FlatMap_Lookup",
+                       "[template]",
+                       ((FlatMapLayout LayoutV), LayoutV),
+                       FlatMapLayout::Sorted,
+                       FlatMapLayout::Eytzinger)
+{
+    for (size_t count : { 0, 1, 2, 3, 7, 8, 100, 1000, 4097 }) {
+        Vector<std::pair<int, int>> pairs = _MakeRandomPairs(count, count);
+        FlatMap<int, int, LayoutV> map(pairs.begin(), pairs.end());
+        REQUIRE(map.size() == count);
+
+        std::map<int, int> reference(pairs.begin(), pairs.end());
+        for (const auto& [key, value] : reference) {
+            REQUIRE(map.contains(key));
+            REQUIRE(map.at(key) == value);
+
+            // Keys between entries are missing.
+            REQUIRE(map.contains(key + 1) == reference.contains(key + 1));
+            REQUIRE(map.contains(key - 1) == reference.contains(key - 1));
+        }
+        CHECK(!map.contains(-1));
+        CHECK(map.find(-1) == nullptr);
+        CHECK_THROWS_AS(map.at(-1), std::out_of_range);
+    }
+}
+
+TEST_CASE("FlatMap_Build")
+{
+    // The first of duplicate keys is kept.
+    FlatMap<std::string, int> map{
+        { "b", 1 }, { "a", 2 }, { "b", 3 }, { "c", 4 }
+    };
+    CHECK(map.size() == 3);
+    CHECK(map.at("b") == 1);
+    CHECK(map.keys()[0] == "a");
+    CHECK(map.keys()[2] == "c");
+    CHECK(map.values()[0] == 2);
+
+    FlatMap<std::string, int, FlatMapLayout::Eytzinger> tree{
+        { "b", 1 }, { "a", 2 }, { "b", 3 }, { "c", 4 }
+    };
+    CHECK(tree.at("b") == 1);
+
+    // The root of the tree is the median key.
+    CHECK(tree.keys()[0] == "b");
+    CHECK(tree.find_index("c") == 2);
+
+    *map.find("c") = 5;
+    CHECK(map.at("c") == 5);
+}
+
+TEST_CASE("FlatMap_InsertErase")
+{
+    FlatMap<int, std::string> map;
+    CHECK(map.empty());
+    CHECK(map.insert(3, "3"));
+    CHECK(map.insert(1, "1"));
+    CHECK(map.insert(2, "2"));
+    CHECK(!map.insert(2, "two"));
+    CHECK(map.at(2) == "2");
+    CHECK(std::is_sorted(map.keys().begin(), map.keys().end()));
+
+    CHECK(map.erase(1));
+    CHECK(!map.erase(1));
+    CHECK(map.size() == 2);
+    CHECK(map.keys()[0] == 2);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(!map.contains(2));
+}
@@ -0,0 +1,55 @@
+#include <catch2/catch.hpp>
+
+#include "growthPolicy.h"
+#include "vector.h"
+
+TEST_CASE("GrowthPolicy_Doubling")
+{
+    CHECK(DoublingGrowth::NextCapacity(0, 1, 4) == 1);
+    CHECK(DoublingGrowth::NextCapacity(1, 2, 4) == 2);
+    CHECK(DoublingGrowth::NextCapacity(4, 5, 4) == 8);
+    CHECK(DoublingGrowth::NextCapacity(4, 20, 4) == 32);
+}
+
+TEST_CASE("GrowthPolicy_OneAndHalf")
+{
+    CHECK(OneAndHalfGrowth::NextCapacity(0, 1, 4) == 1);
+    CHECK(OneAndHalfGrowth::NextCapacity(1, 2, 4) == 2);
+    CHECK(OneAndHalfGrowth::NextCapacity(2, 3, 4) == 3);
+    CHECK(OneAndHalfGrowth::NextCapacity(100, 101, 4) == 150);
+}
+
+TEST_CASE("GrowthPolicy_FixedIncrement")
+{
+    using GrowthT = FixedIncrementGrowth<10>;
+    CHECK(GrowthT::NextCapacity(0, 1, 4) == 10);
+    CHECK(GrowthT::NextCapacity(10, 11, 4) == 20);
+    CHECK(GrowthT::NextCapacity(10, 35, 4) == 40);
+}
+
+TEST_CASE("GrowthPolicy_PageRounded")
+{
+    using GrowthT = PageRoundedGrowth<DoublingGrowth, 4096>;
+    CHECK(GrowthT::NextCapacity(0, 1, 4) == 1024);
+    CHECK(GrowthT::NextCapacity(1024, 1025, 4) == 2048);
+
+    // Element sizes which do not divide the page size round down to whole
+    // elements, while still covering the requirement.
+    CHECK(GrowthT::NextCapacity(0, 1, 12) == 341);
+}
+
+TEST_CASE("GrowthPolicy_Vector")
+{
+    Vector<int, MallocAllocator<int>, FixedIncrementGrowth<10>> vec;
+    for (int i = 0; i < 25; ++i) {
+        vec.push_back(i);
+    }
+    REQUIRE(vec.capacity() == 30);
+
+    vec.insert(vec.begin(), 10, -1);
+    REQUIRE(vec.size() == 35);
+    REQUIRE(vec.capacity() == 40);
+    REQUIRE(vec[9] == -1);
+    REQUIRE(vec[10] == 0);
+    REQUIRE(vec[34] == 24);
+}
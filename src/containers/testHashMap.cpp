@@ -0,0 +1,95 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "hashMap.h"
+#include "testUtils.h"
+
+// Check that \p map holds the same entries as \p reference.
+template<typename MapT, typename ReferenceT>
+static void _CheckEqual(const MapT& map, const ReferenceT& reference)
+{
+    REQUIRE(map.size() == reference.size());
+    size_t count = 0;
+    for (const auto& [key, value] : map) {
+        auto it = reference.find(key);
+        REQUIRE(it != reference.end());
+        REQUIRE(it->second == value);
+        count++;
+    }
+    REQUIRE(count == reference.size());
+}
+
+TEST_CASE("HashMap_Empty")
+{
+    HashMap<int, int> map;
+    CHECK(map.empty());
+    CHECK(map.capacity() == 0);
+    CHECK(map.begin() == map.end());
+    CHECK(map.find(1) == map.end());
+    CHECK(!map.contains(1));
+    CHECK(map.erase(1) == 0);
+    CHECK_THROWS_AS(map.at(1), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("HashMap_InsertFind", "[template]", int, std::string)
+{
+    HashMap<TestType, size_t> map;
+    for (size_t index = 0; index < 10'000; ++index) {
+        auto [it, inserted] =
+            map.insert({ _MakeValue<TestType>(index), index });
+        REQUIRE(inserted);
+        REQUIRE(it->second == index);
+    }
+    CHECK(map.size() == 10'000);
+    CHECK(map.size() <= map.capacity() * 7 / 8);
+
+    for (size_t index = 0; index < 10'000; ++index) {
+        REQUIRE(map.at(_MakeValue<TestType>(index)) == index);
+    }
+    CHECK(!map.contains(_MakeValue<TestType>(10'000)));
+
+    // Present keys are neither inserted nor assigned.
+    auto [it, inserted] = map.try_emplace(_MakeValue<TestType>(5), 0);
+    CHECK(!inserted);
+    CHECK(it->second == 5);
+    map.insert_or_assign(_MakeValue<TestType>(5), 50);
+    CHECK(map.at(_MakeValue<TestType>(5)) == 50);
+    map[_MakeValue<TestType>(20'000)] = 1;
+    CHECK(map.size() == 10'001);
+
+    HashMap<TestType, size_t> copy(map);
+    _CheckEqual(copy, map);
+    HashMap<TestType, size_t> moved(std::move(copy));
+    CHECK(copy.empty());
+    CHECK(moved.size() == 10'001);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+}
+
+TEMPLATE_TEST_CASE("HashMap_Churn", "[template]", int, std::string)
+{
+    // Random inserts and erases over a small key range, which would fill a
+    // tombstone-based table with tombstones.
+    std::mt19937 engine(1);
+    HashMap<TestType, int> map;
+    map.reserve(1000);
+    size_t capacity = map.capacity();
+    std::unordered_map<TestType, int> reference;
+    for (int step = 0; step < 200'000; ++step) {
+        TestType key = _MakeValue<TestType>(engine() % 1000);
+        if (engine() % 2 == 0) {
+            REQUIRE(map.insert({ key, step }).second ==
+                    reference.insert({ key, step }).second);
+        } else {
+            REQUIRE(map.erase(key) == reference.erase(key));
+        }
+    }
+
+    _CheckEqual(map, reference);
+    CHECK(map.capacity() == capacity);
+}
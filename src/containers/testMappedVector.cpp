@@ -0,0 +1,131 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <unistd.h>
+
+#include "mappedVector.h"
+
+// Creates a unique temporary file path, removing the file on destruction.
+class TemporaryFile
+{
+public:
+    TemporaryFile()
+    {
+        char path[] = "/tmp/testMappedVectorXXXXXX";
+        int fd = mkstemp(path);
+        REQUIRE(fd >= 0);
+        close(fd);
+        m_path = path;
+    }
+
+    ~TemporaryFile() { remove(m_path.c_str()); }
+
+    const std::string& path() const { return m_path; }
+
+private:
+    std::string m_path;
+};
+
+// Get the size of the file at \p path, in bytes.
+static size_t _FileSize(const std::string& path)
+{
+    struct stat fileStat;
+    REQUIRE(stat(path.c_str(), &fileStat) == 0);
+    return fileStat.st_size;
+}
+
+TEST_CASE("MappedVector_EmptyFile")
+{
+    TemporaryFile file;
+    MappedVector<int> vec(file.path());
+    CHECK(vec.empty());
+    CHECK(vec.data() == nullptr);
+    CHECK(vec.begin() == vec.end());
+}
+
+TEST_CASE("MappedVector_ReadWrite")
+{
+    TemporaryFile file;
+    {
+        MappedVector<int, MapMode::ReadWrite> vec(file.path());
+        for (int i = 0; i < 10'000; ++i) {
+            vec.push_back(i);
+        }
+        REQUIRE(vec.size() == 10'000);
+        REQUIRE(vec.capacity() >= 10'000);
+        vec.advise(MADV_SEQUENTIAL);
+
+        // Capacity is reserved in the file itself.
+        REQUIRE(_FileSize(file.path()) == sizeof(int) * vec.capacity());
+    }
+
+    // The file is truncated to the size of the vector.
+    REQUIRE(_FileSize(file.path()) == sizeof(int) * 10'000);
+
+    // Re-open the elements read-only.
+    MappedVector<int> vec(file.path());
+    REQUIRE(vec.mode() == MapMode::ReadOnly);
+    REQUIRE(vec.size() == 10'000);
+    CHECK(vec.front() == 0);
+    CHECK(vec.back() == 9'999);
+    CHECK(std::accumulate(vec.begin(), vec.end(), 0l) == 49'995'000l);
+    CHECK_THROWS_AS(vec.at(10'000), std::out_of_range);
+}
+
+TEST_CASE("MappedVector_ReadOnlyAccess")
+{
+    // Elements of a read-only mapping are only accessible as const.
+    using ReadOnlyVector = MappedVector<int>;
+    STATIC_REQUIRE(ReadOnlyVector::mode() == MapMode::ReadOnly);
+    STATIC_REQUIRE(std::is_same_v<decltype(std::declval<ReadOnlyVector&>()[0]),
+                                  const int&>);
+    STATIC_REQUIRE(std::is_same_v<ReadOnlyVector::iterator, const int*>);
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(std::declval<ReadOnlyVector&>().data()),
+                       const int*>);
+
+    using ReadWriteVector = MappedVector<int, MapMode::ReadWrite>;
+    STATIC_REQUIRE(
+        std::is_same_v<decltype(std::declval<ReadWriteVector&>()[0]), int&>);
+    STATIC_REQUIRE(std::is_same_v<ReadWriteVector::iterator, int*>);
+}
+
+TEST_CASE("MappedVector_resize")
+{
+    TemporaryFile file;
+    {
+        MappedVector<double, MapMode::ReadWrite> vec(file.path());
+        vec.resize(100);
+        vec[99] = 1.5;
+        vec.resize(50);
+        vec.resize(100);
+        CHECK(vec[99] == 0.0);
+        vec[0] = 2.5;
+        vec.sync();
+    }
+
+    MappedVector<double, MapMode::ReadWrite> vec(file.path());
+    REQUIRE(vec.size() == 100);
+    CHECK(vec[0] == 2.5);
+
+    // Move semantics transfer the mapping.
+    MappedVector<double, MapMode::ReadWrite> moved(std::move(vec));
+    CHECK(moved.size() == 100);
+    CHECK(vec.size() == 0);
+}
+
+TEST_CASE("MappedVector_InvalidFile")
+{
+    CHECK_THROWS_AS(MappedVector<int>("/nonexistent/file"), std::system_error);
+
+    TemporaryFile file;
+    FILE* stream = fopen(file.path().c_str(), "w");
+    fputs("abc", stream);
+    fclose(stream);
+    CHECK_THROWS_AS(MappedVector<int>(file.path()), std::runtime_error);
+}
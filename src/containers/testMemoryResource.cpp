@@ -0,0 +1,225 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "memoryResource.h"
+#include "vector.h"
+
+// Upstream resource which counts outstanding allocations.
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocations = 0;
+    size_t outstanding = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocations++;
+        outstanding++;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+    {
+        outstanding--;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+//
+// MonotonicArena
+//
+
+TEST_CASE("MonotonicArena_allocate")
+{
+    CountingResource upstream;
+    MonotonicArena arena(1024, &upstream);
+
+    // Allocations are sequential within a chunk and honor alignment.
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % 8 == 0);
+    REQUIRE(static_cast<char*>(b) - static_cast<char*>(a) < 16);
+    REQUIRE(upstream.allocations == 1);
+
+    // Requests larger than the chunk size trigger a new, larger chunk.
+    void* c = arena.allocate(4096, 64);
+    REQUIRE(reinterpret_cast<uintptr_t>(c) % 64 == 0);
+    REQUIRE(upstream.allocations == 2);
+
+    // De-allocation does not return memory upstream.
+    arena.deallocate(c, 4096, 64);
+    REQUIRE(upstream.outstanding == 2);
+
+    arena.release();
+    REQUIRE(upstream.outstanding == 0);
+}
+
+TEST_CASE("MonotonicArena_InitialBuffer")
+{
+    CountingResource upstream;
+    alignas(std::max_align_t) char buffer[256];
+    MonotonicArena arena(buffer, sizeof(buffer), &upstream);
+
+    void* a = arena.allocate(128, 8);
+    REQUIRE(a == buffer);
+    REQUIRE(upstream.allocations == 0);
+
+    REQUIRE(arena.allocate(256, 8) != nullptr);
+    REQUIRE(upstream.allocations == 1);
+
+    // Releasing re-uses the initial buffer, rather than going upstream.
+    arena.release();
+    REQUIRE(upstream.outstanding == 0);
+    REQUIRE(arena.allocate(128, 8) == buffer);
+    REQUIRE(upstream.allocations == 1);
+}
+
+TEST_CASE("MonotonicArena_Vector")
+{
+    CountingResource upstream;
+    {
+        MonotonicArena arena(1024, &upstream);
+        pmr::Vector<std::string> vec(&arena);
+        for (size_t i = 0; i < 100; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+
+        REQUIRE(vec.size() == 100);
+        for (size_t i = 0; i < 100; ++i) {
+            REQUIRE(vec[i] == std::to_string(i));
+        }
+        REQUIRE(vec.get_allocator().resource() == &arena);
+        REQUIRE(upstream.allocations > 0);
+    }
+    REQUIRE(upstream.outstanding == 0);
+}
+
+TEST_CASE("MonotonicArena_VectorMoveAcrossResources")
+{
+    MonotonicArena arenaA;
+    MonotonicArena arenaB;
+    pmr::Vector<std::string> vecA({ "foo", "bar" }, &arenaA);
+    pmr::Vector<std::string> vecB(&arenaB);
+
+    // Allocators differ and do not propagate, so elements are moved one by
+    // one into storage owned by arenaB.
+    vecB = std::move(vecA);
+    REQUIRE(vecB.get_allocator().resource() == &arenaB);
+    REQUIRE(vecB.size() == 2);
+    REQUIRE(vecB[0] == "foo");
+    REQUIRE(vecB[1] == "bar");
+    REQUIRE(vecA.size() == 0);
+}
+
+//
+// PoolResource
+//
+
+TEST_CASE("PoolResource_allocate")
+{
+    CountingResource upstream;
+    PoolResource pool(24, 4, &upstream);
+    REQUIRE(pool.block_size() % alignof(std::max_align_t) == 0);
+    REQUIRE(pool.block_size() >= 24);
+
+    // A single chunk serves the first batch of blocks.
+    void* blocks[4];
+    for (size_t i = 0; i < 4; ++i) {
+        blocks[i] = pool.allocate(24);
+    }
+    REQUIRE(upstream.allocations == 1);
+
+    // Freed blocks are recycled.
+    pool.deallocate(blocks[2], 24);
+    REQUIRE(pool.allocate(16) == blocks[2]);
+    REQUIRE(upstream.allocations == 1);
+
+    // The next block requires a new chunk.
+    REQUIRE(pool.allocate(24) != nullptr);
+    REQUIRE(upstream.allocations == 2);
+
+    // Oversized requests go straight upstream.
+    void* large = pool.allocate(1024);
+    REQUIRE(upstream.allocations == 3);
+    pool.deallocate(large, 1024);
+    REQUIRE(upstream.outstanding == 2);
+
+    pool.release();
+    REQUIRE(upstream.outstanding == 0);
+}
+
+TEST_CASE("PoolResource_Vector")
+{
+    PoolResource pool(sizeof(int) * 16);
+    for (size_t iteration = 0; iteration < 8; ++iteration) {
+        pmr::Vector<int> vec(&pool);
+        vec.reserve(16);
+        for (int i = 0; i < 16; ++i) {
+            vec.push_back(i);
+        }
+        REQUIRE(vec.size() == 16);
+        REQUIRE(vec[15] == 15);
+    }
+}
+
+//
+// Benchmarks
+//
+
+TEST_CASE("MemoryResource_ShortLivedVectors", "[.][benchmark]")
+{
+    constexpr size_t numVectors = 10'000;
+    constexpr size_t numElements = 16;
+
+    BENCHMARK("Vector")
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < numVectors; ++i) {
+            Vector<size_t> vec;
+            vec.reserve(numElements);
+            for (size_t j = 0; j < numElements; ++j) {
+                vec.push_back(j);
+            }
+            total += vec.size();
+        }
+        return total;
+    };
+
+    BENCHMARK("pmr::Vector with MonotonicArena")
+    {
+        size_t total = 0;
+        MonotonicArena arena;
+        for (size_t i = 0; i < numVectors; ++i) {
+            pmr::Vector<size_t> vec(&arena);
+            vec.reserve(numElements);
+            for (size_t j = 0; j < numElements; ++j) {
+                vec.push_back(j);
+            }
+            total += vec.size();
+        }
+        return total;
+    };
+
+    BENCHMARK("pmr::Vector with PoolResource")
+    {
+        size_t total = 0;
+        PoolResource pool(sizeof(size_t) * numElements);
+        for (size_t i = 0; i < numVectors; ++i) {
+            pmr::Vector<size_t> vec(&pool);
+            vec.reserve(numElements);
+            for (size_t j = 0; j < numElements; ++j) {
+                vec.push_back(j);
+            }
+            total += vec.size();
+        }
+        return total;
+    };
+}
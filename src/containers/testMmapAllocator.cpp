@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "mmapAllocator.h"
+
+TEST_CASE("MmapAllocator_allocate")
+{
+    MmapAllocator<int> allocator;
+    AllocationResult<int*> allocation = allocator.allocate_at_least(10);
+    REQUIRE(allocation.ptr != nullptr);
+    REQUIRE(allocation.count * sizeof(int) % sysconf(_SC_PAGESIZE) == 0);
+
+    // Fresh mappings are zero-filled.
+    for (size_t i = 0; i < allocation.count; ++i) {
+        REQUIRE(allocation.ptr[i] == 0);
+        allocation.ptr[i] = i;
+    }
+
+    // Re-mapping preserves contents.
+    size_t newCount = allocation.count * 64;
+    int* ptr = allocator.reallocate(allocation.ptr, allocation.count, newCount);
+    for (size_t i = 0; i < allocation.count; ++i) {
+        REQUIRE(ptr[i] == int(i));
+    }
+
+    allocator.deallocate(ptr, newCount);
+}
+
+TEST_CASE("HugeVector_Trivial")
+{
+    HugeVector<int> vec;
+    vec.push_back(0);
+    REQUIRE(vec.capacity() * sizeof(int) % sysconf(_SC_PAGESIZE) == 0);
+
+    for (int i = 1; i < 1'000'000; ++i) {
+        vec.push_back(i);
+    }
+    REQUIRE(vec.size() == 1'000'000);
+    REQUIRE(vec.capacity() * sizeof(int) % sysconf(_SC_PAGESIZE) == 0);
+    size_t mismatches = 0;
+    for (int i = 0; i < 1'000'000; ++i) {
+        mismatches += vec[i] != i;
+    }
+    REQUIRE(mismatches == 0);
+
+    vec.erase(vec.begin(), vec.begin() + 500'000);
+    vec.shrink_to_fit();
+    REQUIRE(vec.size() == 500'000);
+    REQUIRE(vec.front() == 500'000);
+    REQUIRE(vec.back() == 999'999);
+}
+
+TEST_CASE("HugeVector_NonTrivial")
+{
+    HugeVector<std::string> vec;
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(std::to_string(i));
+    }
+    REQUIRE(vec.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(vec[i] == std::to_string(i));
+    }
+}
+
+//
+// Benchmarks
+//
+
+TEMPLATE_TEST_CASE("HugeVector_push_back_100M",
+                   "[.][benchmark][template]",
+                   (Vector<int>),
+                   (HugeVector<int>),
+                   (HugeVector<int, OneAndHalfGrowth>))
+{
+    constexpr size_t numElements = 100'000'000;
+    BENCHMARK("push_back")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(i);
+        }
+        return vec.size();
+    };
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "mpmcQueue.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEST_CASE("MpmcQueue_SingleThread")
+{
+    MpmcQueue<std::string> queue(3);
+    CHECK(queue.capacity() == 4);
+
+    std::string value;
+    CHECK(!queue.try_pop(value));
+    CHECK(queue.try_pop_batch(&value, 0) == 0);
+    CHECK(queue.try_push("0"));
+    CHECK(queue.try_emplace(2, '1'));
+    CHECK(queue.size_approx() == 2);
+
+    // Batches are truncated to what fits, or what is there.
+    std::string values[4] = { "2", "3", "4", "5" };
+    CHECK(queue.try_push_batch(values, 0) == 0);
+    CHECK(queue.try_push_batch(values, 4) == 2);
+    CHECK(!queue.try_push("full"));
+    CHECK(queue.try_pop(value));
+    CHECK(value == "0");
+    CHECK(queue.try_pop_batch(values, 4) == 3);
+    CHECK(values[0] == "11");
+    CHECK(values[2] == "3");
+    CHECK(!queue.try_pop(value));
+
+    // Timed operations give up.
+    CHECK(!queue.try_pop_for(value, std::chrono::milliseconds(10)));
+    for (int i = 0; i < 4; ++i) {
+        queue.push("x");
+    }
+    CHECK(!queue.try_push_for("y", std::chrono::milliseconds(10)));
+    CHECK(queue.try_pop_for(value, std::chrono::milliseconds(10)));
+    CHECK(queue.try_push_for("y", std::chrono::milliseconds(10)));
+
+    // Timeouts beyond the range of the clock wait without a deadline.
+    CHECK(queue.try_pop_for(value, std::chrono::seconds::max()));
+    CHECK(queue.try_push_for("z", std::chrono::nanoseconds::max()));
+    CHECK(queue.try_pop_for(value, std::chrono::hours::max()));
+
+    // A throwing construction claims no cell, which would stall consumers.
+    size_t size = queue.size_approx();
+    CHECK_THROWS_AS(queue.try_emplace(std::string::npos, 'x'),
+                    std::length_error);
+    CHECK(queue.size_approx() == size);
+    while (queue.try_pop(value)) {
+    }
+    CHECK(queue.try_push("w"));
+    CHECK(queue.try_pop(value));
+    CHECK(value == "w");
+
+    // Remaining elements are destroyed with the queue.
+}
+
+TEMPLATE_TEST_CASE("MpmcQueue_Blocking", "[template]", int, std::string)
+{
+    constexpr size_t numProducers = 3;
+    constexpr size_t numConsumers = 3;
+    constexpr size_t numElements = 60'000;
+
+    // A small queue makes producers and consumers park on each other.
+    MpmcQueue<TestType> queue(8);
+    Vector<size_t> counts(numElements);
+    std::atomic<size_t> consumed = 0;
+
+    Vector<std::thread> threads;
+    for (size_t producer = 0; producer < numProducers; ++producer) {
+        threads.emplace_back([&, producer] {
+            Vector<TestType> batch;
+            for (size_t index = producer; index < numElements;
+                 index += numProducers) {
+                if (index % 2 == 0) {
+                    queue.push(_MakeValue<TestType>(index));
+                } else {
+                    batch.push_back(_MakeValue<TestType>(index));
+                    if (batch.size() == 5) {
+                        queue.push_batch(batch.data(), batch.size());
+                        batch.clear();
+                    }
+                }
+            }
+            queue.push_batch(batch.data(), batch.size());
+        });
+    }
+
+    // Each consumer takes its share, so that none waits forever.
+    for (size_t consumer = 0; consumer < numConsumers; ++consumer) {
+        threads.emplace_back([&, consumer] {
+            size_t share = numElements / numConsumers;
+            TestType batch[4];
+            for (size_t taken = 0; taken < share;) {
+                size_t count = 1;
+                if (consumer == 0) {
+                    count = queue.pop_batch(
+                        batch, std::min<size_t>(4, share - taken));
+                } else {
+                    queue.pop(batch[0]);
+                }
+                for (size_t index = 0; index < count; ++index) {
+                    counts[_GetIndex(batch[index])]++;
+                }
+                taken += count;
+            }
+            consumed += share;
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    CHECK(consumed == numElements);
+    CHECK(queue.size_approx() == 0);
+    CHECK(std::all_of(
+        counts.begin(), counts.end(), [](size_t count) { return count == 1; }));
+}
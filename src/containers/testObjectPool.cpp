@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <string>
+#include <thread>
+
+#include "objectPool.h"
+#include "vector.h"
+
+TEST_CASE("ObjectPool_SingleThread")
+{
+    ObjectPool<std::string> pool(3, "x");
+    CHECK(pool.capacity() == 3);
+
+    std::set<std::string*> objects;
+    for (int index = 0; index < 3; ++index) {
+        std::string* object = pool.try_acquire();
+        REQUIRE(object != nullptr);
+        CHECK(*object == "x");
+        objects.insert(object);
+    }
+    CHECK(objects.size() == 3);
+    CHECK(pool.try_acquire() == nullptr);
+
+    // Released objects keep their value, and are reused first.
+    std::string* object = *objects.begin();
+    *object = "y";
+    pool.release(object);
+    CHECK(pool.acquire() == object);
+    CHECK(*object == "y");
+
+    for (std::string* object : objects) {
+        pool.release(object);
+    }
+
+    ObjectPool<int> empty(0);
+    CHECK(empty.try_acquire() == nullptr);
+
+    // Objects are linked by 32-bit index.
+    CHECK_THROWS_AS(ObjectPool<char>(size_t(UINT32_MAX) + 1),
+                    std::length_error);
+}
+
+TEST_CASE("ObjectPool_Threads")
+{
+    // Threads borrow more objects than there are, so some wait.
+    constexpr size_t numThreads = 4;
+    constexpr size_t numIterations = 50'000;
+    ObjectPool<size_t> pool(3, 0);
+
+    Vector<std::thread> threads;
+    for (size_t thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back([&] {
+            for (size_t index = 0; index < numIterations; ++index) {
+                size_t* object = pool.acquire();
+                (*object)++;
+                pool.release(object);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Every object is free again, and counted each borrow.
+    size_t total = 0;
+    for (int index = 0; index < 3; ++index) {
+        size_t* object = pool.try_acquire();
+        REQUIRE(object != nullptr);
+        total += *object;
+    }
+    CHECK(pool.try_acquire() == nullptr);
+    CHECK(total == numThreads * numIterations);
+}
@@ -0,0 +1,179 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "parallelAlgorithms.h"
+#include "smallVector.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEMPLATE_TEST_CASE("ParallelEraseIf",
+                   "[template]",
+                   (Vector<int>),
+                   (Vector<std::string>),
+                   (SmallVector<int, 4>))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 100'000;
+    constexpr size_t grainSize = 1000;
+
+    TestType vec;
+    for (size_t i = 0; i < numElements; ++i) {
+        vec.push_back(_MakeValue<ValueT>(i));
+    }
+
+    // No matches leaves the vector untouched.
+    const ValueT* data = vec.data();
+    CHECK(ParallelEraseIf(
+              vec, [](const ValueT&) { return false; }, grainSize) == 0);
+    CHECK(vec.data() == data);
+    CHECK(vec.size() == numElements);
+
+    // Erase every third element, across many chunks, preserving order.
+    size_t erasedCount = ParallelEraseIf(
+        vec,
+        [](const ValueT& value) { return _GetIndex(value) % 3 == 0; },
+        grainSize);
+    CHECK(erasedCount == (numElements + 2) / 3);
+    REQUIRE(vec.size() == numElements - erasedCount);
+
+    size_t mismatches = 0;
+    for (size_t i = 0, index = 1; i < vec.size(); ++i, ++index) {
+        if (index % 3 == 0) {
+            ++index;
+        }
+        mismatches += vec[i] != _MakeValue<ValueT>(index);
+    }
+    CHECK(mismatches == 0);
+
+    // Small vectors are compacted serially.
+    TestType small{ _MakeValue<ValueT>(1), _MakeValue<ValueT>(3) };
+    CHECK(ParallelEraseIf(
+              small,
+              [](const ValueT& value) { return _GetIndex(value) == 3; },
+              grainSize) == 1);
+    REQUIRE(small.size() == 1);
+    CHECK(small[0] == _MakeValue<ValueT>(1));
+}
+
+TEMPLATE_TEST_CASE("ParallelCopy",
+                   "[template]",
+                   (Vector<int>),
+                   (Vector<std::string>),
+                   (SmallVector<int, 4>))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 100'000;
+    constexpr size_t grainSize = 1000;
+
+    TestType src;
+    for (size_t i = 0; i < numElements; ++i) {
+        src.push_back(_MakeValue<ValueT>(i));
+    }
+
+    // Copy construction.
+    auto copy = ParallelCopy(src, grainSize);
+    REQUIRE(copy.size() == numElements);
+
+    // Assignment over a larger vector.
+    TestType assigned(numElements * 2, _MakeValue<ValueT>(7));
+    ParallelAssign(assigned, src, grainSize);
+    REQUIRE(assigned.size() == numElements);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < numElements; ++i) {
+        mismatches += copy[i] != src[i];
+        mismatches += assigned[i] != src[i];
+    }
+    CHECK(mismatches == 0);
+
+    // Small vectors are copied serially.
+    TestType small{ _MakeValue<ValueT>(1) };
+    ParallelAssign(assigned, small, grainSize);
+    REQUIRE(assigned.size() == 1);
+    CHECK(assigned[0] == _MakeValue<ValueT>(1));
+}
+
+TEMPLATE_TEST_CASE("ParallelAssign_Fill",
+                   "[template]",
+                   (Vector<int>),
+                   (Vector<std::string>))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 100'000;
+    constexpr size_t grainSize = 1000;
+
+    TestType vec{ _MakeValue<ValueT>(1), _MakeValue<ValueT>(2) };
+    ParallelAssign(vec, numElements, _MakeValue<ValueT>(3), grainSize);
+    REQUIRE(vec.size() == numElements);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < numElements; ++i) {
+        mismatches += vec[i] != _MakeValue<ValueT>(3);
+    }
+    CHECK(mismatches == 0);
+
+    // Shrinking.
+    ParallelAssign(vec, 2, _MakeValue<ValueT>(4), grainSize);
+    REQUIRE(vec.size() == 2);
+    CHECK(vec[1] == _MakeValue<ValueT>(4));
+}
+
+TEMPLATE_TEST_CASE("ParallelResize",
+                   "[template]",
+                   (Vector<int>),
+                   (Vector<std::string>))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 100'000;
+    constexpr size_t grainSize = 1000;
+
+    // Existing elements are preserved, appended ones are filled.
+    TestType vec{ _MakeValue<ValueT>(1), _MakeValue<ValueT>(2) };
+    ParallelResize(vec, numElements, _MakeValue<ValueT>(3), grainSize);
+    REQUIRE(vec.size() == numElements);
+    CHECK(vec[0] == _MakeValue<ValueT>(1));
+    CHECK(vec[1] == _MakeValue<ValueT>(2));
+
+    size_t mismatches = 0;
+    for (size_t i = 2; i < numElements; ++i) {
+        mismatches += vec[i] != _MakeValue<ValueT>(3);
+    }
+    CHECK(mismatches == 0);
+
+    // Value-initialized by default.
+    ParallelResize(vec, numElements * 2, ValueT(), grainSize);
+    REQUIRE(vec.size() == numElements * 2);
+    CHECK(vec[numElements * 2 - 1] == ValueT());
+
+    ParallelResize(vec, 1, ValueT(), grainSize);
+    REQUIRE(vec.size() == 1);
+    CHECK(vec[0] == _MakeValue<ValueT>(1));
+}
+
+//
+// Benchmarks
+//
+
+TEST_CASE("ParallelEraseIf_100M", "[.][benchmark]")
+{
+    constexpr size_t numElements = 100'000'000;
+    Vector<int> src(numElements, DefaultInit);
+    for (size_t i = 0; i < numElements; ++i) {
+        src[i] = i % 10;
+    }
+    auto predicate = [](int value) { return value == 3 || value == 7; };
+
+    BENCHMARK_ADVANCED("erase_if")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Vector<int>> vecs(meter.runs(), src);
+        meter.measure([&](int run) { return vecs[run].erase_if(predicate); });
+    };
+
+    BENCHMARK_ADVANCED("ParallelEraseIf")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<Vector<int>> vecs(meter.runs(), src);
+        meter.measure(
+            [&](int run) { return ParallelEraseIf(vecs[run], predicate); });
+    };
+}
@@ -0,0 +1,118 @@
+#include <catch2/catch.hpp>
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include "segmentedVector.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEST_CASE("SegmentedVector_Iterator")
+{
+    using VectorT = SegmentedVector<int, 16>;
+    STATIC_REQUIRE(std::random_access_iterator<VectorT::iterator>);
+    STATIC_REQUIRE(std::random_access_iterator<VectorT::const_iterator>);
+
+    VectorT vec;
+    CHECK(vec.empty());
+    CHECK(vec.begin() == vec.end());
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    VectorT::const_iterator it = vec.begin();
+    CHECK(it[999] == 999);
+    CHECK(vec.end() - vec.begin() == 1000);
+    CHECK(std::distance(vec.begin(), std::find(vec.begin(), vec.end(), 42)) ==
+          42);
+    CHECK_THROWS_AS(vec.at(1000), std::out_of_range);
+
+    std::sort(vec.begin(), vec.end(), std::greater<int>());
+    CHECK(vec.front() == 999);
+    CHECK(vec.back() == 0);
+}
+
+TEMPLATE_TEST_CASE("SegmentedVector_StableAddresses",
+                   "[template]",
+                   int,
+                   std::string)
+{
+    SegmentedVector<TestType, 64> vec;
+    Vector<const TestType*> addresses;
+    for (size_t index = 0; index < 10'000; ++index) {
+        addresses.push_back(&vec.emplace_back(_MakeValue<TestType>(index)));
+    }
+
+    // Growth never moves elements.
+    CHECK(vec.capacity() == 10'048);
+    CHECK(vec.chunk_count() == 157);
+    for (size_t index = 0; index < vec.size(); ++index) {
+        REQUIRE(&vec[index] == addresses[index]);
+        REQUIRE(vec[index] == _MakeValue<TestType>(index));
+    }
+
+    vec.pop_back();
+    vec.resize(5'000);
+    CHECK(vec.size() == 5'000);
+    CHECK(&vec[4'999] == addresses[4'999]);
+    vec.shrink_to_fit();
+    CHECK(vec.capacity() == 5'056);
+
+    vec.resize(6'000, _MakeValue<TestType>(7));
+    CHECK(vec[5'999] == _MakeValue<TestType>(7));
+    CHECK(&vec[0] == addresses[0]);
+
+    SegmentedVector<TestType, 64> copy(vec);
+    CHECK(copy.size() == 6'000);
+    CHECK(std::equal(copy.begin(), copy.end(), vec.begin()));
+
+    SegmentedVector<TestType, 64> moved;
+    moved = std::move(vec);
+    CHECK(vec.empty());
+    CHECK(&moved[0] == addresses[0]);
+
+    moved.clear();
+    CHECK(moved.empty());
+    CHECK(moved.capacity() == 6'016);
+}
+
+TEST_CASE("SegmentedVector_Chunks")
+{
+    SegmentedVector<size_t, 1024> vec(100'000);
+    CHECK(vec.chunk_count() == 98);
+    CHECK(vec.chunk(0).size() == 1024);
+    CHECK(vec.chunk(97).size() == 100'000 - 97 * 1024);
+
+    // Chunks are contiguous, and may be processed in parallel.
+    tbb::parallel_for(size_t(0), vec.chunk_count(), [&](size_t chunkIndex) {
+        std::span<size_t> elements = vec.chunk(chunkIndex);
+        std::iota(elements.begin(), elements.end(), chunkIndex * 1024);
+    });
+    for (size_t index = 0; index < vec.size(); ++index) {
+        REQUIRE(vec[index] == index);
+    }
+}
+
+TEST_CASE("SegmentedVector_ConstructorThrows")
+{
+    using VectorT = SegmentedVector<LiveCounted, 16>;
+    {
+        VectorT vec(100);
+        REQUIRE(LiveCounted::s_live == 100);
+
+        // The elements copied before the failure, spanning several chunks,
+        // are destroyed along with their chunks.
+        LiveCounted::s_copiesLeft = 50;
+        CHECK_THROWS_AS(VectorT(vec), std::runtime_error);
+        CHECK(LiveCounted::s_live == 100);
+
+        LiveCounted::s_copiesLeft = 50;
+        CHECK_THROWS_AS(VectorT(100, vec[0]), std::runtime_error);
+        CHECK(LiveCounted::s_live == 100);
+        LiveCounted::s_copiesLeft = -1;
+    }
+    CHECK(LiveCounted::s_live == 0);
+}
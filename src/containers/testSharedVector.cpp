@@ -0,0 +1,189 @@
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sharedVector.h"
+#include "vector.h"
+
+// Creates a unique shared memory segment name, unlinking the segment on
+// destruction.
+class TemporarySegment
+{
+public:
+    TemporarySegment()
+      : m_name("/testSharedVector" + std::to_string(getpid()) + "_" +
+               std::to_string(s_counter++))
+    {}
+
+    ~TemporarySegment() { SharedVector<int>::unlink(m_name); }
+
+    const std::string& name() const { return m_name; }
+
+private:
+    static inline int s_counter = 0;
+    std::string m_name;
+};
+
+// Run \p fn in a child process, which exits with the status it returns.
+template<typename FnT>
+static pid_t _ForkChild(FnT&& fn)
+{
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        _exit(fn());
+    }
+
+    return pid;
+}
+
+// Wait for the child process \p pid, returning its exit status.
+static int _WaitChild(pid_t pid)
+{
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+// Poll \p vec until it holds at least \p count elements, then sum them.
+static long _WaitAndSum(SharedVector<int>& vec, size_t count)
+{
+    while (vec.refresh() < count) {
+        sched_yield();
+    }
+
+    return std::accumulate(vec.begin(), vec.begin() + count, 0l);
+}
+
+TEST_CASE("SharedVector_WriterReader")
+{
+    TemporarySegment segment;
+    SharedVector<int> writer(segment.name(), MapMode::ReadWrite, 16);
+    REQUIRE(writer.empty());
+    REQUIRE(writer.capacity() == 16);
+    writer.push_back(1);
+    writer.push_back(2);
+
+    SharedVector<int> reader(segment.name());
+    REQUIRE(reader.size() == 2);
+    CHECK(reader[0] == 1);
+    CHECK(reader[1] == 2);
+    CHECK_THROWS_AS(reader.push_back(3), std::logic_error);
+
+    // Appends are only visible after a refresh, re-mapping on growth.
+    Vector<int> values(10'000);
+    std::iota(values.begin(), values.end(), 0);
+    writer.append(values.data(), values.size());
+    REQUIRE(writer.capacity() >= 10'002);
+    CHECK(reader.size() == 2);
+    REQUIRE(reader.refresh() == 10'002);
+    CHECK(reader[2] == 0);
+    CHECK(reader[10'001] == 9'999);
+    CHECK(std::accumulate(reader.begin(), reader.end(), 0l) ==
+          3l + 49'995'000l);
+
+    // Move semantics transfer the mapping.
+    SharedVector<int> moved(std::move(reader));
+    CHECK(moved.size() == 10'002);
+    CHECK(reader.size() == 0);
+}
+
+TEST_CASE("SharedVector_Recreate")
+{
+    TemporarySegment segment;
+    SharedVector<int> writer(segment.name(), MapMode::ReadWrite);
+    writer.push_back(1);
+    SharedVector<int> reader(segment.name());
+
+    // A new writer of the same name leaves the old segment to its readers.
+    SharedVector<int> newWriter(segment.name(), MapMode::ReadWrite);
+    newWriter.push_back(2);
+    newWriter.push_back(3);
+    REQUIRE(reader.refresh() == 1);
+    CHECK(reader[0] == 1);
+
+    SharedVector<int> newReader(segment.name());
+    REQUIRE(newReader.size() == 2);
+    CHECK(newReader[0] == 2);
+}
+
+TEST_CASE("SharedVector_InvalidSegment")
+{
+    CHECK_THROWS_AS(SharedVector<int>("/testSharedVectorMissing"),
+                    std::system_error);
+
+    TemporarySegment segment;
+    SharedVector<int> writer(segment.name(), MapMode::ReadWrite);
+    CHECK_THROWS_AS(SharedVector<double>(segment.name()), std::runtime_error);
+}
+
+TEST_CASE("SharedVector_OpenDuringCreation")
+{
+    // Stand in for a writer which has created the segment, but has not yet
+    // sized it or written its header.
+    TemporarySegment segment;
+    int fd = shm_open(segment.name().c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+    REQUIRE(fd >= 0);
+
+    // A reader fails cleanly if the header is never published.
+    CHECK_THROWS_AS(SharedVector<int>(segment.name()), std::runtime_error);
+
+    // Otherwise it waits for the header, published with the version last.
+    size_t readerSize = 1;
+    std::thread readerThread([&] {
+        SharedVector<int> reader(segment.name());
+        readerSize = reader.size();
+    });
+
+    constexpr size_t segmentBytes = 4096;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(ftruncate(fd, segmentBytes) == 0);
+    void* ptr =
+        mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    REQUIRE(ptr != MAP_FAILED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // The header starts with the version, followed by the element size.
+    std::uint32_t* header = static_cast<std::uint32_t*>(ptr);
+    header[1] = sizeof(int);
+    reinterpret_cast<std::atomic<std::uint32_t>*>(header)->store(
+        SharedVector<int>::version, std::memory_order_release);
+
+    readerThread.join();
+    CHECK(readerSize == 0);
+    munmap(ptr, segmentBytes);
+    close(fd);
+}
+
+TEST_CASE("SharedVector_ForkedReaders")
+{
+    constexpr size_t numElements = 1'000'000;
+    constexpr long expectedSum = long(numElements) * (numElements - 1) / 2;
+    TemporarySegment segment;
+    SharedVector<int> writer(segment.name(), MapMode::ReadWrite);
+
+    // Readers map the segment while it is still empty, and must re-map it
+    // as the writer grows it.
+    pid_t pids[2];
+    for (pid_t& pid : pids) {
+        pid = _ForkChild([&] {
+            SharedVector<int> reader(segment.name());
+            return _WaitAndSum(reader, numElements) == expectedSum ? 0 : 1;
+        });
+    }
+
+    for (size_t index = 0; index < numElements; ++index) {
+        writer.push_back(int(index));
+    }
+
+    for (pid_t pid : pids) {
+        CHECK(_WaitChild(pid) == 0);
+    }
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "smallVector.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEST_CASE("SmallVector_InlineStorage")
+{
+    SmallVector<std::string, 4> vec;
+    REQUIRE(!vec.is_inline());
+    REQUIRE(vec.capacity() == 0);
+
+    // The first allocation is served inline, at full inline capacity.
+    vec.push_back("foo");
+    REQUIRE(vec.is_inline());
+    REQUIRE(vec.capacity() == 4);
+
+    vec.push_back("bar");
+    vec.push_back("baz");
+    vec.push_back("qux");
+    REQUIRE(vec.is_inline());
+    REQUIRE(vec.capacity() == 4);
+
+    // Exceeding the inline capacity spills to the heap.
+    vec.push_back("lux");
+    REQUIRE(!vec.is_inline());
+    REQUIRE(vec.capacity() == 8);
+    REQUIRE(vec[0] == "foo");
+    REQUIRE(vec[4] == "lux");
+
+    // Shrinking back within the inline capacity returns to inline storage.
+    vec.pop_back();
+    vec.shrink_to_fit();
+    REQUIRE(vec.is_inline());
+    REQUIRE(vec.size() == 4);
+    REQUIRE(vec[3] == "qux");
+}
+
+TEST_CASE("SmallVector_CopyAndMove")
+{
+    SmallVector<std::string, 4> inlineVec{ "foo", "bar" };
+    SmallVector<std::string, 4> heapVec{ "a", "b", "c", "d", "e" };
+    REQUIRE(inlineVec.is_inline());
+    REQUIRE(!heapVec.is_inline());
+
+    // Copies get their own inline storage.
+    SmallVector<std::string, 4> copy(inlineVec);
+    REQUIRE(copy.is_inline());
+    REQUIRE(copy.data() != inlineVec.data());
+    REQUIRE(copy[1] == "bar");
+
+    // Moving inline elements moves them one by one.
+    SmallVector<std::string, 4> moved(std::move(copy));
+    REQUIRE(moved.is_inline());
+    REQUIRE(moved.size() == 2);
+    REQUIRE(moved[0] == "foo");
+    REQUIRE(copy.size() == 0);
+
+    // Moving heap elements adopts the buffer.
+    const std::string* heapData = heapVec.data();
+    SmallVector<std::string, 4> adopted;
+    adopted = std::move(heapVec);
+    REQUIRE(adopted.data() == heapData);
+    REQUIRE(adopted.size() == 5);
+
+    // Swapping mixed storage.
+    moved.swap(adopted);
+    REQUIRE(moved.size() == 5);
+    REQUIRE(moved.data() == heapData);
+    REQUIRE(adopted.size() == 2);
+    REQUIRE(adopted.is_inline());
+    REQUIRE(adopted[1] == "bar");
+}
+
+//
+// Benchmarks
+//
+
+TEMPLATE_TEST_CASE("SmallVector_push_back",
+                   "[.][benchmark][template]",
+                   (Vector<int, CountingAllocator<int>>),
+                   (SmallVector<int, 16, CountingAllocator<int>>))
+{
+    constexpr size_t numVectors = 100'000;
+    for (size_t numElements : { 4, 8, 16, 32 }) {
+        s_allocatorCalls = 0;
+        for (size_t i = 0; i < numVectors; ++i) {
+            TestType vec;
+            for (size_t j = 0; j < numElements; ++j) {
+                vec.push_back(j);
+            }
+        }
+        WARN(numElements << " elements: "
+                         << double(s_allocatorCalls) / numVectors
+                         << " allocations per vector");
+
+        BENCHMARK(std::to_string(numElements) + " elements")
+        {
+            size_t total = 0;
+            for (size_t i = 0; i < numVectors; ++i) {
+                TestType vec;
+                for (size_t j = 0; j < numElements; ++j) {
+                    vec.push_back(j);
+                }
+                total += vec.size();
+            }
+            return total;
+        };
+    }
+}
@@ -0,0 +1,110 @@
+#include <catch2/catch.hpp>
+
+#include "soaVector.h"
+#include "vector.h"
+
+namespace {
+
+// Test type.
+struct Vec3f
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+// Test type with heterogeneous members.
+struct Particle
+{
+    double mass = 0.0;
+    int id = 0;
+    char tag = 0;
+};
+
+} // namespace
+
+template<>
+struct SoALayout<Vec3f>
+{
+    static constexpr auto members =
+        std::make_tuple(&Vec3f::x, &Vec3f::y, &Vec3f::z);
+};
+
+template<>
+struct SoALayout<Particle>
+{
+    static constexpr auto members =
+        std::make_tuple(&Particle::mass, &Particle::id, &Particle::tag);
+};
+
+TEST_CASE("SoAVector_push_back")
+{
+    SoAVector<Vec3f> vec;
+    REQUIRE(vec.empty());
+
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(Vec3f{ float(i), float(i * 2), float(i * 3) });
+    }
+    REQUIRE(vec.size() == 100);
+    REQUIRE(vec.capacity() >= 100);
+
+    // Re-assemble records through proxy references.
+    Vec3f record = vec[10];
+    CHECK(record.x == 10.0f);
+    CHECK(record.y == 20.0f);
+    CHECK(record.z == 30.0f);
+    CHECK(vec[99].get<&Vec3f::z>() == 297.0f);
+
+    vec.pop_back();
+    REQUIRE(vec.size() == 99);
+}
+
+TEST_CASE("SoAVector_ProxyAssignment")
+{
+    SoAVector<Particle> vec;
+    vec.push_back(Particle{ 1.5, 1, 'a' });
+    vec.push_back(Particle{ 2.5, 2, 'b' });
+
+    // Assign a record.
+    vec[0] = Particle{ 3.5, 3, 'c' };
+    CHECK(vec[0].get<&Particle::mass>() == 3.5);
+    CHECK(vec[0].get<&Particle::id>() == 3);
+    CHECK(vec[0].get<&Particle::tag>() == 'c');
+
+    // Assign between references copies values, rather than re-binding.
+    vec[1] = vec[0];
+    CHECK(vec[1].get<&Particle::id>() == 3);
+    vec[0].get<&Particle::id>() = 4;
+    CHECK(vec[1].get<&Particle::id>() == 3);
+
+    const SoAVector<Particle>& constVec = vec;
+    Particle particle = constVec[0];
+    CHECK(particle.id == 4);
+    CHECK(particle.tag == 'c');
+}
+
+TEST_CASE("SoAVector_column")
+{
+    SoAVector<Particle> vec;
+    vec.resize(1000);
+    REQUIRE(vec.size() == 1000);
+
+    // Each column is contiguous and cache-line aligned.
+    std::span<double> masses = vec.column<&Particle::mass>();
+    std::span<int> ids = vec.column<&Particle::id>();
+    std::span<char> tags = vec.column<&Particle::tag>();
+    REQUIRE(masses.size() == 1000);
+    REQUIRE(reinterpret_cast<uintptr_t>(masses.data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(ids.data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(tags.data()) % 64 == 0);
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = i;
+    }
+    CHECK(Particle(vec[500]).id == 500);
+    CHECK(Particle(vec[500]).mass == 0.0);
+
+    vec.clear();
+    CHECK(vec.empty());
+    CHECK(vec.column<&Particle::tag>().empty());
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+
+#include "spscRing.h"
+#include "testUtils.h"
+#include "vector.h"
+
+TEST_CASE("SpscRing_SingleThread")
+{
+    SpscRing<std::string> ring(5);
+    CHECK(ring.capacity() == 8);
+    CHECK(ring.size_approx() == 0);
+
+    std::string value;
+    CHECK(!ring.try_pop(value));
+    for (size_t index = 0; index < 8; ++index) {
+        REQUIRE(ring.try_push(_MakeValue<std::string>(index)));
+    }
+    CHECK(!ring.try_push("full"));
+    CHECK(ring.size_approx() == 8);
+
+    CHECK(ring.try_pop(value));
+    CHECK(value == "0");
+    CHECK(ring.try_emplace(3, 'x'));
+    CHECK(ring.size_approx() == 8);
+
+    // Batches are truncated to what fits, or what is there.
+    std::string values[10];
+    CHECK(ring.pop_batch(values, 3) == 3);
+    CHECK(values[2] == "3");
+    CHECK(ring.push_batch(values, 10) == 3);
+    CHECK(ring.pop_batch(values, 10) == 8);
+    CHECK(values[4] == "xxx");
+    CHECK(values[7] == "3");
+    CHECK(!ring.try_pop(value));
+
+    // Remaining elements are destroyed with the ring.
+    CHECK(ring.try_push("leftover"));
+}
+
+TEST_CASE("SpscRing_BatchThrows")
+{
+    {
+        SpscRing<LiveCounted> ring(8);
+        LiveCounted values[5];
+
+        // The elements copied before the failure are published.
+        LiveCounted::s_copiesLeft = 3;
+        CHECK_THROWS_AS(ring.push_batch(values, 5), std::runtime_error);
+        CHECK(ring.size_approx() == 3);
+        CHECK(LiveCounted::s_live == 5 + 3);
+
+        // The elements moved out before the failure are removed.
+        LiveCounted::s_movesLeft = 1;
+        CHECK_THROWS_AS(ring.pop_batch(values, 5), std::runtime_error);
+        CHECK(ring.size_approx() == 2);
+        CHECK(LiveCounted::s_live == 5 + 2);
+        LiveCounted::s_copiesLeft = -1;
+        LiveCounted::s_movesLeft = -1;
+    }
+    CHECK(LiveCounted::s_live == 0);
+}
+
+TEMPLATE_TEST_CASE("SpscRing_TwoThreads", "[template]", int, std::string)
+{
+    constexpr size_t numElements = 200'000;
+    SpscRing<TestType> ring(64);
+
+    SECTION("single")
+    {
+        std::thread producer([&] {
+            for (size_t index = 0; index < numElements; ++index) {
+                while (!ring.try_push(_MakeValue<TestType>(index))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        // Elements arrive in order.
+        TestType value;
+        for (size_t index = 0; index < numElements; ++index) {
+            while (!ring.try_pop(value)) {
+                std::this_thread::yield();
+            }
+            REQUIRE(value == _MakeValue<TestType>(index));
+        }
+        producer.join();
+    }
+
+    SECTION("batch")
+    {
+        std::thread producer([&] {
+            Vector<TestType> batch;
+            for (size_t index = 0; index < numElements; index += 50) {
+                batch.clear();
+                for (size_t offset = 0; offset < 50; ++offset) {
+                    batch.push_back(_MakeValue<TestType>(index + offset));
+                }
+                size_t pushed = 0;
+                while (pushed < 50) {
+                    pushed +=
+                        ring.push_batch(batch.data() + pushed, 50 - pushed);
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        Vector<TestType> batch(37);
+        size_t index = 0;
+        while (index < numElements) {
+            size_t popped = ring.pop_batch(batch.data(), batch.size());
+            for (size_t offset = 0; offset < popped; ++offset) {
+                REQUIRE(batch[offset] == _MakeValue<TestType>(index++));
+            }
+        }
+        producer.join();
+    }
+
+    CHECK(ring.size_approx() == 0);
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "allocator.h"
+
+// Helpers shared by the container test files.
+
+/// Make a distinct test value for \p index.
+template<typename ValueT>
+ValueT _MakeValue(size_t index)
+{
+    if constexpr (std::is_same<ValueT, std::string>::value) {
+        return std::to_string(index);
+    } else {
+        return ValueT(index);
+    }
+}
+
+/// Get the index which \p value was made from by \ref _MakeValue.
+template<typename ValueT>
+size_t _GetIndex(const ValueT& value)
+{
+    if constexpr (std::is_same<ValueT, std::string>::value) {
+        return std::stoul(value);
+    } else {
+        return size_t(value);
+    }
+}
+
+/// Number of allocations performed through CountingAllocator and
+/// CountingStdAllocator.
+inline size_t s_allocatorCalls = 0;
+
+/// MallocAllocator which counts allocations and reallocations.
+template<typename ValueT>
+class CountingAllocator : public MallocAllocator<ValueT>
+{
+public:
+    CountingAllocator() = default;
+
+    template<typename OtherT>
+    CountingAllocator(const CountingAllocator<OtherT>&) noexcept
+    {}
+
+    ValueT* allocate(std::size_t count)
+    {
+        s_allocatorCalls++;
+        return MallocAllocator<ValueT>::allocate(count);
+    }
+
+    ValueT* reallocate(ValueT* ptr, std::size_t oldCount, std::size_t newCount)
+    {
+        s_allocatorCalls++;
+        return MallocAllocator<ValueT>::reallocate(ptr, oldCount, newCount);
+    }
+};
+
+/// std::allocator which counts allocations, for element types which own a
+/// heap buffer.
+template<typename ValueT>
+class CountingStdAllocator : public std::allocator<ValueT>
+{
+public:
+    template<typename OtherT>
+    struct rebind
+    {
+        using other = CountingStdAllocator<OtherT>;
+    };
+
+    CountingStdAllocator() = default;
+
+    template<typename OtherT>
+    CountingStdAllocator(const CountingStdAllocator<OtherT>&) noexcept
+    {}
+
+    ValueT* allocate(std::size_t count)
+    {
+        s_allocatorCalls++;
+        return std::allocator<ValueT>::allocate(count);
+    }
+};
+
+/// MallocAllocator which counts the blocks currently allocated.
+template<typename ValueT>
+class LiveBlockAllocator : public MallocAllocator<ValueT>
+{
+public:
+    static inline int s_liveBlocks = 0;
+
+    ValueT* allocate(std::size_t count)
+    {
+        s_liveBlocks++;
+        return MallocAllocator<ValueT>::allocate(count);
+    }
+
+    void deallocate(ValueT* ptr, std::size_t count)
+    {
+        s_liveBlocks--;
+        MallocAllocator<ValueT>::deallocate(ptr, count);
+    }
+};
+
+/// Element which counts its live instances, for checking that containers
+/// neither leak nor double-destroy elements when an operation throws.
+///
+/// Copies, by construction or assignment, throw once \p s_copiesLeft runs
+/// out, and move assignments throw once \p s_movesLeft runs out.  Negative
+/// budgets never run out.  Move construction never throws.
+struct LiveCounted
+{
+    static inline int s_live = 0;
+    static inline int s_copiesLeft = -1;
+    static inline int s_movesLeft = -1;
+
+    LiveCounted() { s_live++; }
+
+    explicit LiveCounted(int _value)
+      : value(_value)
+    {
+        s_live++;
+    }
+
+    LiveCounted(const LiveCounted& other)
+      : value(other.value)
+    {
+        _Spend(s_copiesLeft);
+        s_live++;
+    }
+
+    LiveCounted(LiveCounted&& other) noexcept
+      : value(other.value)
+    {
+        s_live++;
+    }
+
+    LiveCounted& operator=(const LiveCounted& other)
+    {
+        _Spend(s_copiesLeft);
+        value = other.value;
+        return *this;
+    }
+
+    LiveCounted& operator=(LiveCounted&& other)
+    {
+        _Spend(s_movesLeft);
+        value = other.value;
+        return *this;
+    }
+
+    ~LiveCounted() { s_live--; }
+
+    // Use up one of \p budget, throwing if none is left.
+    static void _Spend(int& budget)
+    {
+        if (budget == 0) {
+            throw std::runtime_error("Transfer failed.");
+        }
+        budget--;
+    }
+
+    int value = 0;
+};
@@ -1,9 +1,29 @@
 #include <catch2/catch.hpp>
 
+#include <list>
+#include <ranges>
+#include <sstream>
+
+#include "smallVector.h"
+#include "testUtils.h"
 #include "vector.h"
 
 static const char* s_templateProduct = "[template][product]";
 
+// SmallVector with a small inline capacity, so that the shared test cases
+// exercise both inline and spilled storage.
+template<typename ValueT>
+using SmallVector4 = SmallVector<ValueT, 4>;
+
+// Benchmarks are hidden from the default run.  Select them explicitly with:
+//   containers_test "[benchmark]" --benchmark-samples 10
+static const char* s_benchmarkProduct = "[.][benchmark][template][product]";
+
+// Element types whose buffers are allocated through CountingStdAllocator.
+using CountingString = std::
+    basic_string<char, std::char_traits<char>, CountingStdAllocator<char>>;
+using CountingIntVector = std::vector<int, CountingStdAllocator<int>>;
+
 // Test type.
 struct Vec3f
 {
@@ -37,7 +57,7 @@ inline std::ostream& operator<<(std::ostream& stream, const Vec3f& value)
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_DefaultConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -47,7 +67,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_DefaultConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec(5);
@@ -56,7 +76,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeAndDefaultValueConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float))
 {
     TestType vec(5, 5);
@@ -68,7 +88,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeAndDefaultValueConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeAndDefaultValueConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec(5, "foo");
@@ -80,7 +100,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_SizeAndDefaultValueConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_CopyConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vecA;
@@ -96,7 +116,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_CopyConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_InitializerListConstructor",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec{
@@ -115,7 +135,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_InitializerListConstructor",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_CopyAssignmentOperator",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vecA;
@@ -131,7 +151,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_CopyAssignmentOperator",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_InitializerListAssignmentOperator",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -151,7 +171,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_InitializerListAssignmentOperator",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_assign",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int))
 {
     TestType vec;
@@ -170,7 +190,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_assign",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_assign_InitializerList",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -194,7 +214,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_assign_InitializerList",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_AssignmentOperator",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -207,7 +227,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_AssignmentOperator",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_at",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -222,7 +242,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_at",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_front",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -236,7 +256,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_front",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_back",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -254,7 +274,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_back",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_begin",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -266,7 +286,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_begin",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_IncrementForwards",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -283,7 +303,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_IncrementForwards",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_IncrementBackwards",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -302,7 +322,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_IncrementBackwards",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Difference",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -323,7 +343,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Difference",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Addition",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -337,7 +357,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Addition",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Subtraction",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -356,7 +376,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_iterator_Subtraction",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_empty",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -369,7 +389,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_empty",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_reserve",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -388,7 +408,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_reserve",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_shrink_to_fit",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -422,7 +442,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_shrink_to_fit",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_clear",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -440,7 +460,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_clear",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float))
 {
     TestType vec;
@@ -460,7 +480,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -478,7 +498,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_emplace_back",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (Vec3f))
 {
     TestType vec;
@@ -495,7 +515,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_emplace_back",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_pop_back",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -524,7 +544,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_pop_back",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_resize",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float, std::string))
 {
     TestType vec;
@@ -550,9 +570,293 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_resize",
     }
 }
 
+TEMPLATE_PRODUCT_TEST_CASE("Vector_resize_DefaultInit",
+                           s_templateProduct,
+                           (Vector, SmallVector4),
+                           (int, float, std::string))
+{
+    // Existing elements are preserved, and new elements are writable.
+    TestType vec{ typename TestType::value_type() };
+    vec.resize(10, DefaultInit);
+    REQUIRE(vec.size() == 10);
+    REQUIRE(vec.capacity() == 10);
+    REQUIRE(vec[0] == typename TestType::value_type());
+    for (size_t i = 1; i < 10; ++i) {
+        vec[i] = vec[0];
+    }
+
+    vec.resize(3, DefaultInit);
+    REQUIRE(vec.size() == 3);
+    REQUIRE(vec.capacity() == 10);
+
+    TestType sized(5, DefaultInit);
+    REQUIRE(sized.size() == 5);
+    REQUIRE(sized.capacity() == 5);
+}
+
+TEST_CASE("Vector_resize_DefaultInitNonTrivial")
+{
+    // Non-trivial types are still default-constructed.
+    Vector<std::string> vec(4, DefaultInit);
+    for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(vec[i].empty());
+    }
+
+    Vector<Vec3f> vecs;
+    vecs.resize(4, DefaultInit);
+    for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(vecs[i] == Vec3f());
+    }
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_TriviallyRelocatable",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (int, float))
+{
+    STATIC_REQUIRE(
+        IsTriviallyRelocatable<typename TestType::value_type>::value);
+
+    TestType vec;
+    for (size_t i = 0; i < 100; ++i) {
+        vec.push_back(typename TestType::value_type(i));
+    }
+
+    // Insert in the middle, shifting the right range.
+    vec.insert(vec.begin() + 10, 5, typename TestType::value_type(-1));
+    REQUIRE(vec.size() == 105);
+    CHECK(vec[9] == typename TestType::value_type(9));
+    for (size_t i = 10; i < 15; ++i) {
+        CHECK(vec[i] == typename TestType::value_type(-1));
+    }
+    CHECK(vec[15] == typename TestType::value_type(10));
+    CHECK(vec[104] == typename TestType::value_type(99));
+
+    // Erase the inserted range back out.
+    vec.erase(vec.begin() + 10, vec.begin() + 15);
+    REQUIRE(vec.size() == 100);
+    for (size_t i = 0; i < 100; ++i) {
+        REQUIRE(vec[i] == typename TestType::value_type(i));
+    }
+
+    // Shrinking must preserve contents.
+    vec.shrink_to_fit();
+    REQUIRE(vec.capacity() == 100);
+    for (size_t i = 0; i < 100; ++i) {
+        REQUIRE(vec[i] == typename TestType::value_type(i));
+    }
+}
+
+// Owning pointer wrapper, which is relocatable bytewise but not trivially
+// copyable, and counts live instances.
+struct RelocatableOwner
+{
+    static inline int s_live = 0;
+
+    explicit RelocatableOwner(int value)
+      : ptr(std::make_unique<int>(value))
+    {
+        s_live++;
+    }
+
+    RelocatableOwner(RelocatableOwner&& other) noexcept
+      : ptr(std::move(other.ptr))
+    {
+        s_live++;
+    }
+
+    RelocatableOwner& operator=(RelocatableOwner&&) noexcept = default;
+
+    ~RelocatableOwner() { s_live--; }
+
+    std::unique_ptr<int> ptr;
+};
+
+template<>
+struct IsTriviallyRelocatable<RelocatableOwner> : std::true_type
+{};
+
+TEST_CASE("Vector_TriviallyRelocatableErase")
+{
+    {
+        Vector<RelocatableOwner> vec;
+        for (int i = 0; i < 10; ++i) {
+            vec.emplace_back(i);
+        }
+
+        // The erased elements are deconstructed before the tail is shifted.
+        vec.erase(vec.begin() + 2, vec.begin() + 5);
+        REQUIRE(vec.size() == 7);
+        CHECK(RelocatableOwner::s_live == 7);
+        CHECK(*vec[1].ptr == 1);
+        CHECK(*vec[2].ptr == 5);
+        CHECK(*vec[6].ptr == 9);
+    }
+    CHECK(RelocatableOwner::s_live == 0);
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_GrowthMovesElements",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (std::string))
+{
+    // Long enough to defeat the small string optimization, so that a moved
+    // string keeps its heap buffer.
+    TestType vec;
+    vec.push_back(std::string(64, 'a'));
+    const char* data = vec[0].data();
+
+    for (size_t i = 0; i < 100; ++i) {
+        vec.push_back(std::string(64, 'b'));
+        vec.insert(vec.begin() + 1, std::string(64, 'c'));
+    }
+    vec.erase(vec.begin() + 1, vec.begin() + 50);
+
+    REQUIRE(vec.size() == 152);
+    REQUIRE(vec[0] == std::string(64, 'a'));
+    REQUIRE(vec[0].data() == data);
+}
+
+// Element whose copies throw once s_throwOnCopy is set, and whose move may
+// throw, so that growth migrates it by copy.
+struct ThrowingCopy
+{
+    static inline bool s_throwOnCopy = false;
+
+    explicit ThrowingCopy(int _value)
+      : value(_value)
+    {}
+
+    ThrowingCopy(const ThrowingCopy& other)
+      : value(other.value)
+    {
+        if (s_throwOnCopy) {
+            throw std::runtime_error("Copy failed.");
+        }
+    }
+
+    ThrowingCopy(ThrowingCopy&& other) noexcept(false)
+      : value(other.value)
+    {}
+
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    int value;
+};
+
+TEST_CASE("Vector_GrowthCopyThrows")
+{
+    using AllocatorT = LiveBlockAllocator<ThrowingCopy>;
+    {
+        Vector<ThrowingCopy, AllocatorT> vec;
+        vec.reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            vec.emplace_back(i);
+        }
+        REQUIRE(AllocatorT::s_liveBlocks == 1);
+
+        // A failed migration frees the new buffer, and leaves the vector
+        // as it was.
+        ThrowingCopy::s_throwOnCopy = true;
+        CHECK_THROWS_AS(vec.emplace_back(4), std::runtime_error);
+        CHECK_THROWS_AS(vec.insert(vec.begin() + 2, ThrowingCopy(4)),
+                        std::runtime_error);
+        ThrowingCopy::s_throwOnCopy = false;
+
+        CHECK(AllocatorT::s_liveBlocks == 1);
+        REQUIRE(vec.size() == 4);
+        for (int i = 0; i < 4; ++i) {
+            CHECK(vec[i].value == i);
+        }
+    }
+    CHECK(AllocatorT::s_liveBlocks == 0);
+}
+
+TEST_CASE("Vector_InsertInPlaceCopyThrows")
+{
+    // Fewer, then more, inserted elements than there are elements after
+    // the insert location, with the copy failing part way.
+    size_t count = GENERATE(3, 6);
+    int copiesLeft = GENERATE(0, 1, 2);
+    {
+        Vector<LiveCounted> vec;
+        vec.reserve(16);
+        for (int i = 0; i < 4; ++i) {
+            vec.emplace_back(i);
+        }
+
+        LiveCounted value(-1);
+        LiveCounted::s_copiesLeft = copiesLeft;
+        CHECK_THROWS_AS(vec.insert(vec.begin() + 1, count, value),
+                        std::runtime_error);
+        LiveCounted::s_copiesLeft = -1;
+
+        // Every element in the vector is alive, and no other is.
+        CHECK(LiveCounted::s_live == int(vec.size()) + 1);
+    }
+    CHECK(LiveCounted::s_live == 0);
+}
+
+TEMPLATE_TEST_CASE("Vector_Alignment",
+                   "[template]",
+                   (Vector<int>),
+                   (Vector<double>),
+                   (AlignedVector<float, 32>),
+                   (AlignedVector<char, 128>))
+{
+    REQUIRE(TestType::alignment >= 32);
+
+    // Alignment holds through growth, which may re-allocate in place, and
+    // through shrinking.
+    TestType vec;
+    for (size_t i = 0; i < 10'000; ++i) {
+        vec.push_back(typename TestType::value_type(i));
+        REQUIRE(reinterpret_cast<uintptr_t>(vec.data()) % TestType::alignment ==
+                0);
+    }
+
+    vec.resize(3);
+    vec.shrink_to_fit();
+    REQUIRE(reinterpret_cast<uintptr_t>(vec.data()) % TestType::alignment ==
+            0);
+    REQUIRE(vec[2] == typename TestType::value_type(2));
+}
+
+TEST_CASE("Vector_NaturalAlignment")
+{
+    REQUIRE(Vector<std::string>::alignment == alignof(std::string));
+    REQUIRE(Vector<Vec3f>::alignment == alignof(Vec3f));
+    REQUIRE(SmallVector4<int>::alignment == alignof(int));
+    REQUIRE(pmr::Vector<int>::alignment == alignof(int));
+}
+
+// Check if the swap member function of \p VectorT cannot throw.
+template<typename VectorT>
+constexpr bool _IsNothrowMemberSwap()
+{
+    return noexcept(std::declval<VectorT&>().swap(std::declval<VectorT&>()));
+}
+
+TEST_CASE("Vector_MoveConstructorNoexcept")
+{
+    // A move-constructed allocator always adopts the storage of the source.
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Vector<std::string>>);
+    STATIC_REQUIRE(
+        std::is_nothrow_move_constructible_v<pmr::Vector<std::string>>);
+    STATIC_REQUIRE(_IsNothrowMemberSwap<Vector<std::string>>());
+
+    // Inline storage is moved element by element, which only throws if the
+    // element move does.
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<SmallVector4<int>>);
+    STATIC_REQUIRE(_IsNothrowMemberSwap<SmallVector4<int>>());
+    STATIC_REQUIRE(
+        !std::is_nothrow_move_constructible_v<SmallVector4<ThrowingCopy>>);
+    STATIC_REQUIRE(!_IsNothrowMemberSwap<SmallVector4<ThrowingCopy>>());
+}
+
 TEMPLATE_PRODUCT_TEST_CASE("Vector_swap",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (int, float))
 {
     // Create vecA.
@@ -587,7 +891,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_swap",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_single_value",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -625,7 +929,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_single_value",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_multiple_values",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -668,7 +972,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_multiple_values",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_initializer_list",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -691,9 +995,120 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_initializer_list",
     CHECK(vec[5] == typename TestType::value_type("Baz"));
 }
 
+TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_range",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    TestType vec{ ValueT(), ValueT() };
+
+    // Contiguous source.
+    std::vector<ValueT> contiguous(5);
+    for (size_t i = 0; i < contiguous.size(); ++i) {
+        contiguous[i] = _MakeValue<ValueT>(i + 1);
+    }
+    typename TestType::iterator it =
+        vec.insert(vec.begin() + 1, contiguous.begin(), contiguous.end());
+    CHECK(it - vec.begin() == 1);
+
+    // Non-contiguous source.
+    std::list<ValueT> linked{ _MakeValue<ValueT>(6), _MakeValue<ValueT>(7) };
+    it = vec.insert(vec.end(), linked.begin(), linked.end());
+    CHECK(it - vec.begin() == 7);
+
+    // Empty source.
+    it = vec.insert(vec.begin(), linked.end(), linked.end());
+    CHECK(it == vec.begin());
+
+    REQUIRE(vec.size() == 9);
+    CHECK(vec[0] == ValueT());
+    for (size_t i = 1; i < 6; ++i) {
+        CHECK(vec[i] == _MakeValue<ValueT>(i));
+    }
+    CHECK(vec[6] == ValueT());
+    CHECK(vec[7] == _MakeValue<ValueT>(6));
+    CHECK(vec[8] == _MakeValue<ValueT>(7));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_InputIterator",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (int))
+{
+    TestType vec{ 1, 5 };
+    std::istringstream stream("2 3 4");
+    vec.insert(vec.begin() + 1,
+               std::istream_iterator<int>(stream),
+               std::istream_iterator<int>());
+    REQUIRE(vec.size() == 5);
+    for (int i = 0; i < 5; ++i) {
+        CHECK(vec[i] == i + 1);
+    }
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_RangeConstructor",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    const TestType src{ _MakeValue<ValueT>(1),
+                        _MakeValue<ValueT>(2),
+                        _MakeValue<ValueT>(3) };
+    TestType vec(src.begin(), src.end());
+    REQUIRE(vec.size() == 3);
+    CHECK(vec.capacity() >= 3);
+    CHECK(vec[0] == _MakeValue<ValueT>(1));
+    CHECK(vec[2] == _MakeValue<ValueT>(3));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_append_range",
+                           s_templateProduct,
+                           (Vector, SmallVector4),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    TestType vec{ _MakeValue<ValueT>(0) };
+
+    TestType other{ _MakeValue<ValueT>(1), _MakeValue<ValueT>(2) };
+    vec.append_range(other);
+    vec.append_range(std::list<ValueT>{ _MakeValue<ValueT>(3) });
+    vec.append_range(std::views::iota(4, 6) |
+                     std::views::transform(_MakeValue<ValueT>));
+
+    REQUIRE(vec.size() == 6);
+    for (size_t i = 0; i < 6; ++i) {
+        CHECK(vec[i] == _MakeValue<ValueT>(i));
+    }
+}
+
+TEST_CASE("Vector_append_range_SingleAllocation")
+{
+    Vector<int> vec{ 1, 2, 3 };
+    const int* data = vec.data();
+    vec.reserve(16);
+    data = vec.data();
+
+    // Fits in the existing capacity: no re-allocation.
+    std::vector<int> src(13, 7);
+    vec.append_range(src);
+    REQUIRE(vec.data() == data);
+    REQUIRE(vec.size() == 16);
+    REQUIRE(vec[15] == 7);
+}
+
+TEST_CASE("Vector_iterator_Concepts")
+{
+    STATIC_REQUIRE(std::contiguous_iterator<Vector<int>::iterator>);
+    STATIC_REQUIRE(std::contiguous_iterator<Vector<std::string>::iterator>);
+    STATIC_REQUIRE(std::ranges::contiguous_range<Vector<int>>);
+    STATIC_REQUIRE(std::ranges::sized_range<Vector<int>>);
+}
+
 TEMPLATE_PRODUCT_TEST_CASE("Vector_emplace",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (Vec3f))
 {
     TestType vec;
@@ -714,7 +1129,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_emplace",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_erase",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -742,7 +1157,7 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_erase",
 
 TEMPLATE_PRODUCT_TEST_CASE("Vector_erase_range",
                            s_templateProduct,
-                           (std::vector, Vector),
+                           (std::vector, Vector, SmallVector4),
                            (std::string))
 {
     TestType vec;
@@ -774,3 +1189,261 @@ TEMPLATE_PRODUCT_TEST_CASE("Vector_erase_range",
         CHECK(vec[0] == typename TestType::value_type("Foo"));
     }
 }
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_swap_erase",
+                           s_templateProduct,
+                           (Vector, SmallVector4),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    TestType vec;
+    for (size_t i = 0; i < 5; ++i) {
+        vec.push_back(_MakeValue<ValueT>(i));
+    }
+
+    // The last element takes the place of the erased one.
+    typename TestType::iterator it = vec.swap_erase(vec.begin() + 1);
+    REQUIRE(vec.size() == 4);
+    CHECK(it - vec.begin() == 1);
+    CHECK(vec[0] == _MakeValue<ValueT>(0));
+    CHECK(vec[1] == _MakeValue<ValueT>(4));
+    CHECK(vec[2] == _MakeValue<ValueT>(2));
+    CHECK(vec[3] == _MakeValue<ValueT>(3));
+
+    // Erasing the last element.
+    it = vec.swap_erase(vec.end() - 1);
+    REQUIRE(vec.size() == 3);
+    CHECK(it == vec.end());
+    CHECK(vec[2] == _MakeValue<ValueT>(2));
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_erase_if",
+                           s_templateProduct,
+                           (std::vector, Vector, SmallVector4),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    TestType vec;
+    for (size_t i = 0; i < 10; ++i) {
+        vec.push_back(_MakeValue<ValueT>(i % 3));
+    }
+
+    // Erase scattered elements, preserving order.
+    size_t erasedCount = erase_if(vec, [](const ValueT& value) {
+        return value == _MakeValue<ValueT>(1);
+    });
+    CHECK(erasedCount == 3);
+    REQUIRE(vec.size() == 7);
+    const size_t expected[] = { 0, 2, 0, 2, 0, 2, 0 };
+    for (size_t i = 0; i < 7; ++i) {
+        CHECK(vec[i] == _MakeValue<ValueT>(expected[i]));
+    }
+
+    // No matches.
+    CHECK(erase_if(vec, [](const ValueT&) { return false; }) == 0);
+    CHECK(vec.size() == 7);
+
+    // All matches.
+    CHECK(erase_if(vec, [](const ValueT&) { return true; }) == 7);
+    CHECK(vec.empty());
+}
+
+//
+// Benchmarks
+//
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back_100M",
+                           s_benchmarkProduct,
+                           (std::vector, Vector),
+                           (int, float))
+{
+    constexpr size_t numElements = 100'000'000;
+    BENCHMARK("push_back")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(typename TestType::value_type(i));
+        }
+        return vec.size();
+    };
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back_100M",
+                           s_benchmarkProduct,
+                           (std::vector, Vector),
+                           (Vec3f))
+{
+    constexpr size_t numElements = 100'000'000;
+    BENCHMARK("push_back")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(typename TestType::value_type(i, i, i));
+        }
+        return vec.size();
+    };
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_push_back_1M",
+                           s_benchmarkProduct,
+                           (std::vector, Vector),
+                           (CountingString, CountingIntVector))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 1'000'000;
+
+    // Each element owns a heap buffer, so deep copies on growth show up as
+    // additional heap allocations.
+    const ValueT element(64, typename ValueT::value_type());
+
+    size_t allocationsBefore = s_allocatorCalls;
+    {
+        TestType vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(element);
+        }
+    }
+    WARN("Heap allocations: " << s_allocatorCalls - allocationsBefore);
+
+    BENCHMARK("push_back")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numElements; ++i) {
+            vec.push_back(element);
+        }
+        return vec.size();
+    };
+}
+
+TEMPLATE_TEST_CASE("Vector_resize_10M",
+                   "[.][benchmark][template]",
+                   int,
+                   float)
+{
+    constexpr size_t numElements = 10'000'000;
+
+    BENCHMARK("std::vector value-initialized")
+    {
+        std::vector<TestType> vec;
+        vec.resize(numElements);
+        for (size_t i = 0; i < numElements; ++i) {
+            vec[i] = TestType(i);
+        }
+        return vec.size();
+    };
+
+    BENCHMARK("Vector value-initialized")
+    {
+        Vector<TestType> vec;
+        vec.resize(numElements);
+        for (size_t i = 0; i < numElements; ++i) {
+            vec[i] = TestType(i);
+        }
+        return vec.size();
+    };
+
+    BENCHMARK("Vector default-initialized")
+    {
+        Vector<TestType> vec;
+        vec.resize(numElements, DefaultInit);
+        for (size_t i = 0; i < numElements; ++i) {
+            vec[i] = TestType(i);
+        }
+        return vec.size();
+    };
+}
+
+TEMPLATE_TEST_CASE("Vector_saxpy_1M",
+                   "[.][benchmark][template]",
+                   (AlignedVector<float, alignof(float)>),
+                   (AlignedVector<float, 64>))
+{
+    constexpr size_t numElements = 1'000'000;
+    TestType x(numElements, 1.0f);
+    TestType y(numElements, 2.0f);
+
+    BENCHMARK("saxpy")
+    {
+        const float* xData = x.data();
+        float* yData = y.data();
+        for (size_t i = 0; i < numElements; ++i) {
+            yData[i] += 3.0f * xData[i];
+        }
+        return yData[numElements - 1];
+    };
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_insert_range_1M",
+                           s_benchmarkProduct,
+                           (std::vector, Vector),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 1'000'000;
+    constexpr size_t numChunks = 100;
+    const std::vector<ValueT> chunk(numElements / numChunks, ValueT());
+
+    BENCHMARK("insert at end")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numChunks; ++i) {
+            vec.insert(vec.end(), chunk.begin(), chunk.end());
+        }
+        return vec.size();
+    };
+
+    BENCHMARK("insert at front")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numChunks; ++i) {
+            vec.insert(vec.begin(), chunk.begin(), chunk.end());
+        }
+        return vec.size();
+    };
+
+    BENCHMARK("push_back loop")
+    {
+        TestType vec;
+        for (size_t i = 0; i < numChunks; ++i) {
+            for (const ValueT& value : chunk) {
+                vec.push_back(value);
+            }
+        }
+        return vec.size();
+    };
+}
+
+TEMPLATE_PRODUCT_TEST_CASE("Vector_erase_if_100K",
+                           s_benchmarkProduct,
+                           (std::vector, Vector),
+                           (int, std::string))
+{
+    using ValueT = typename TestType::value_type;
+    constexpr size_t numElements = 100'000;
+    TestType src;
+    for (size_t i = 0; i < numElements; ++i) {
+        src.push_back(_MakeValue<ValueT>(i % 10));
+    }
+    auto predicate = [](const ValueT& value) {
+        return value == _MakeValue<ValueT>(3);
+    };
+
+    BENCHMARK_ADVANCED("erase_if")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<TestType> vecs(meter.runs(), src);
+        meter.measure([&](int run) { return erase_if(vecs[run], predicate); });
+    };
+
+    // Erasing each matching element individually shifts the tail each time.
+    BENCHMARK_ADVANCED("erase loop")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<TestType> vecs(meter.runs(), src);
+        meter.measure([&](int run) {
+            TestType& vec = vecs[run];
+            for (auto it = vec.begin(); it != vec.end();) {
+                it = predicate(*it) ? vec.erase(it) : it + 1;
+            }
+            return vec.size();
+        });
+    };
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <string>
+
+#include "vector.h"
+#include "vectorStatistics.h"
+
+template<typename ValueT>
+using TrackedVector = Vector<ValueT,
+                             MallocAllocator<ValueT>,
+                             DoublingGrowth,
+                             VectorStatistics>;
+
+// Find the statistics of the call site at \p line of this file.
+static const VectorSiteStatistics* _FindSite(unsigned line)
+{
+    std::string suffix = "testVectorStatistics.cpp:" + std::to_string(line);
+    const VectorSiteStatistics* found = nullptr;
+    VectorStatisticsRegistry::Get().ForEachSite(
+        [&](const VectorSiteStatistics& statistics) {
+            if (statistics.site.find(suffix + " ") != std::string::npos) {
+                found = &statistics;
+            }
+        });
+    return found;
+}
+
+TEST_CASE("VectorStatistics_Disabled")
+{
+    // The default policy occupies no storage.
+    STATIC_REQUIRE(
+        std::is_same_v<Vector<int>::statistics_type, NoVectorStatistics>);
+    STATIC_REQUIRE(sizeof(Vector<int>) == 3 * sizeof(void*));
+}
+
+TEST_CASE("VectorStatistics_Reallocatable")
+{
+    VectorStatisticsRegistry::Get().Reset();
+    unsigned line = __LINE__ + 1;
+    TrackedVector<int> vec;
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    // Capacity doubles from 1 to 1024, in place via realloc.
+    const VectorSiteStatistics* site = _FindSite(line);
+    REQUIRE(site != nullptr);
+    CHECK(site->allocations == 1);
+    CHECK(site->reallocations == 10);
+    CHECK(site->bytesCopied == 0);
+    CHECK(site->elementsConstructed == 1000);
+    CHECK(site->elementsDestroyed == 0);
+    CHECK(site->peakCapacityBytes == 1024 * sizeof(int));
+
+    // Copies are attributed to their own call site.
+    unsigned copyLine = __LINE__ + 1;
+    TrackedVector<int> copy(vec);
+    const VectorSiteStatistics* copySite = _FindSite(copyLine);
+    REQUIRE(copySite != nullptr);
+    CHECK(copySite->allocations == 1);
+    CHECK(copySite->bytesCopied == 1000 * sizeof(int));
+    CHECK(copySite->elementsConstructed == 1000);
+
+    vec.erase(vec.begin(), vec.begin() + 10);
+    CHECK(site->bytesCopied == 990 * sizeof(int));
+    CHECK(site->elementsDestroyed == 10);
+}
+
+TEST_CASE("VectorStatistics_Migrating")
+{
+    VectorStatisticsRegistry::Get().Reset();
+    unsigned line = __LINE__ + 2;
+    {
+        TrackedVector<std::string> vec;
+        for (int i = 0; i < 1000; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+    }
+
+    // Each growth allocates a new buffer, and migrates the elements to it.
+    const VectorSiteStatistics* site = _FindSite(line);
+    REQUIRE(site != nullptr);
+    CHECK(site->allocations == 11);
+    CHECK(site->reallocations == 10);
+    CHECK(site->bytesCopied == 1023 * sizeof(std::string));
+    CHECK(site->elementsConstructed == 1000 + 1023);
+    CHECK(site->elementsDestroyed == 1023 + 1000);
+    CHECK(site->peakCapacityBytes == 1024 * sizeof(std::string));
+}
+
+TEST_CASE("VectorStatistics_Dump")
+{
+    VectorStatisticsRegistry::Get().Reset();
+    unsigned line = __LINE__ + 1;
+    TrackedVector<int> vec(100);
+
+    FILE* stream = tmpfile();
+    REQUIRE(stream != nullptr);
+    VectorStatisticsRegistry::Get().Dump(stream);
+    rewind(stream);
+    std::string contents;
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), stream) != nullptr) {
+        contents += buffer;
+    }
+    fclose(stream);
+
+    CHECK(contents.find("bytes copied") != std::string::npos);
+    CHECK(contents.find("testVectorStatistics.cpp:" + std::to_string(line)) !=
+          std::string::npos);
+}
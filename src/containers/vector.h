@@ -1,15 +1,80 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
-
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <ranges>
+#include <source_location>
+#include <type_traits>
+
+#include "allocator.h"
+#include "growthPolicy.h"
 #include "utils.h"
+#include "vectorStatistics.h"
+
+/// \class IsTriviallyRelocatable
+///
+/// Trait which reports whether objects of type \p T can be moved to a new
+/// address with a raw byte copy, without running constructors or destructors.
+///
+/// Defaults to \p std::is_trivially_copyable.  Specialize this trait for types
+/// which are safe to relocate bytewise but are not trivially copyable.
+///
+/// \tparam T The type to query.
+template<typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T>
+{};
+
+/// \class DefaultInitT
+///
+/// Tag type selecting default-initialization of new elements, rather than
+/// value-initialization.  See \ref DefaultInit.
+struct DefaultInitT
+{
+    explicit DefaultInitT() = default;
+};
+
+/// \var DefaultInit
+///
+/// Pass to \ref Vector::resize or the \ref Vector size constructor to
+/// default-initialize new elements.  For trivial types such as \p int or
+/// \p float this leaves their values indeterminate and only adjusts the size,
+/// skipping the cost of zero-filling a buffer which the caller is about to
+/// overwrite anyway.
+inline constexpr DefaultInitT DefaultInit{};
 
 /// \class Vector
 ///
 /// A dynamically re-sizable, type-homogenous array.
 ///
+/// Storage is obtained through \p AllocatorT, which must model the standard
+/// Allocator requirements.  Use \ref pmr::Vector to allocate from a
+/// \p std::pmr::memory_resource, such as \ref MonotonicArena.
+///
+/// Capacity grows according to \p GrowthPolicyT (see growthPolicy.h).  For
+/// multi-gigabyte buffers, see \ref HugeVector.
+///
+/// By default, storage of arithmetic types is aligned to a cache line (see
+/// \ref DefaultAlignment).  Use \ref AlignedVector to choose the alignment.
+///
+/// Allocations, re-allocations, copies and element lifetimes are reported to
+/// \p StatisticsT, per call site constructing the vector (see
+/// vectorStatistics.h).  By default nothing is recorded, unless
+/// \p CONTAINERS_VECTOR_STATISTICS is defined.
+///
 /// \tparam ValueT The type of each element.
-template<typename ValueT>
+/// \tparam AllocatorT The allocator used to obtain element storage.
+/// \tparam GrowthPolicyT Computes the capacity to grow to.
+/// \tparam StatisticsT Records storage operations.
+template<typename ValueT,
+         typename AllocatorT = MallocAllocator<ValueT>,
+         typename GrowthPolicyT = DoublingGrowth,
+         typename StatisticsT = DefaultVectorStatistics>
 class Vector
 {
 public:
@@ -23,61 +88,209 @@ public:
     /// The value type of the container size.
     using size_type = std::size_t;
 
+    /// \typedef allocator_type
+    ///
+    /// The allocator used to obtain element storage.
+    using allocator_type = AllocatorT;
+
+    /// \typedef growth_policy_type
+    ///
+    /// Computes the capacity to grow to.
+    using growth_policy_type = GrowthPolicyT;
+
+    /// \typedef statistics_type
+    ///
+    /// Records storage operations.
+    using statistics_type = StatisticsT;
+
+    /// The alignment of the element storage, in bytes, as guaranteed by the
+    /// allocator (see \ref AllocatorAlignment).
+    static constexpr size_type alignment = AllocatorAlignment<AllocatorT>;
+
     // -----------------------------------------------------------------------
     /// \name Construction
     // -----------------------------------------------------------------------
 
     /// Constructs an empty vector.
-    Vector() {}
+    ///
+    /// \param location The call site, for \p StatisticsT.
+    Vector(std::source_location location = std::source_location::current())
+      : m_statistics(location)
+    {}
+
+    /// Constructs an empty vector which allocates through \p allocator.
+    ///
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    explicit Vector(
+        const allocator_type& allocator,
+        std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
+    {}
 
     /// Constructs a vector with \p count number of elements.
     ///
     /// \param count The number of elements.
-    explicit Vector(size_type count) { resize(count); }
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    explicit Vector(
+        size_type count,
+        const allocator_type& allocator = allocator_type(),
+        std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
+    {
+        resize(count);
+    }
+
+    /// Constructs a vector with \p count number of default-initialized
+    /// elements.  See \ref DefaultInit.
+    ///
+    /// \param count The number of elements.
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    explicit Vector(
+        size_type count,
+        DefaultInitT,
+        const allocator_type& allocator = allocator_type(),
+        std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
+    {
+        resize(count, DefaultInit);
+    }
 
     /// Constructs a vector with \p count number of elements initialized to \p
     /// value.
     ///
     /// \param count The number of elements.
     /// \param value The default value initialized for each element.
-    explicit Vector(size_type count, const value_type& value)
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    explicit Vector(
+        size_type count,
+        const value_type& value,
+        const allocator_type& allocator = allocator_type(),
+        std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
     {
         resize(count, value);
     }
 
+    /// Constructs a vector with a copy of each element in the range from
+    /// \p first to \p last, allocating once if the range can be measured
+    /// up-front.
+    ///
+    /// \param first The first element in the range.
+    /// \param last The position after the last element in the range.
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    template<std::input_iterator IteratorT>
+    Vector(IteratorT first,
+           IteratorT last,
+           const allocator_type& allocator = allocator_type(),
+           std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
+    {
+        insert(end(), first, last);
+    }
+
     /// Destroys the vector.
     ~Vector() { _Reset(); }
 
     /// Copy constructor.
     ///
     /// \param src The source vector to copy contents from.
-    Vector(const Vector& src) { _CopyFrom(src); }
+    /// \param location The call site, for \p StatisticsT.
+    Vector(const Vector& src,
+           std::source_location location = std::source_location::current())
+      : m_allocator(_AllocatorTraits::select_on_container_copy_construction(
+            src.m_allocator))
+      , m_statistics(location)
+    {
+        _CopyFrom(src);
+    }
 
-    /// Move constructor.
+    /// Move constructor.  The call site of \p src is adopted along with its
+    /// storage.
+    ///
+    /// The allocator is move-constructed from that of \p src, and so can
+    /// always free its storage, except for inline storage, which is instead
+    /// filled by moving the elements one by one.
     ///
     /// \param src The source vector to move resource ownership from.
-    Vector(Vector&& src) noexcept { src.swap(*this); }
+    Vector(Vector&& src) noexcept(_IsNothrowMovable())
+      : m_allocator(std::move(src.m_allocator))
+      , m_statistics(src.m_statistics)
+    {
+        if constexpr (InlineStorageAllocator<allocator_type>) {
+            if (!_CanAdoptStorage(src)) {
+                _MoveElementsFrom(src);
+                return;
+            }
+        }
+
+        _SwapStorage(src);
+    }
 
     /// Initializer-list constructor.
     ///
     /// \param src The source initializer list.
-    Vector(std::initializer_list<value_type> src) { _CopyFromInitList(src); }
+    /// \param allocator The allocator.
+    /// \param location The call site, for \p StatisticsT.
+    Vector(std::initializer_list<value_type> src,
+           const allocator_type& allocator = allocator_type(),
+           std::source_location location = std::source_location::current())
+      : m_allocator(allocator)
+      , m_statistics(location)
+    {
+        _CopyFromInitList(src);
+    }
 
     /// Copy assignment operator.
     ///
     /// \param src The source vector to copy contents from.
     Vector& operator=(const Vector& src)
     {
-        _CopyFrom(src);
+        if (&src != this) {
+            if constexpr (_AllocatorTraits::
+                              propagate_on_container_copy_assignment::value) {
+                // Storage from our allocator cannot be re-used if the incoming
+                // allocator is unable to free it.
+                if (m_allocator != src.m_allocator) {
+                    _Reset();
+                }
+                m_allocator = src.m_allocator;
+            }
+            _CopyFrom(src);
+        }
         return *this;
     }
 
     /// Move assignment operator.
     ///
+    /// If the allocators are not propagated and compare un-equal, or the source
+    /// elements live in inline storage, elements are moved individually into
+    /// storage owned by this vector's allocator.
+    ///
     /// \param src The source vector to move resource ownership from.
-    Vector& operator=(Vector&& src) noexcept
+    Vector& operator=(Vector&& src) noexcept(
+        _AllocatorTraits::propagate_on_container_move_assignment::value ||
+        _AllocatorTraits::is_always_equal::value)
     {
-        src.swap(*this);
+        if constexpr (_AllocatorTraits::propagate_on_container_move_assignment::
+                          value) {
+            std::swap(m_allocator, src.m_allocator);
+            _SwapStorage(src);
+        } else if (_CanAdoptStorage(src)) {
+            _Reset();
+            _SwapStorage(src);
+        } else {
+            _MoveElementsFrom(src);
+        }
         return *this;
     }
 
@@ -95,11 +308,15 @@ public:
     /// \param src The source vector to copy contents from.
     void assign(size_type count, const value_type& value)
     {
-        _ResizeOps(count, _NoOp, [&](void) {
-            for (size_type index = 0; index < count; ++index) {
-                m_buffer[index] = value;
-            }
-        });
+        size_type assignCount = std::min(m_size, count);
+        _ResizeOps(
+            count,
+            [&](size_type index) { new (m_buffer + index) value_type(value); },
+            [&](void) {
+                for (size_type index = 0; index < assignCount; ++index) {
+                    m_buffer[index] = value;
+                }
+            });
     }
 
     /// Replaces elements in this container with an initializer list.
@@ -159,6 +376,27 @@ public:
         return m_buffer[index];
     }
 
+    /// Access the underlying buffer, in a read-only fashion.
+    ///
+    /// The pointer is declared to be aligned to \ref alignment bytes, so that
+    /// loops over it may be vectorized with aligned loads.
+    ///
+    /// \return Pointer to the first element, or \p nullptr if no storage has
+    /// been allocated.
+    const value_type* data() const
+    {
+        return std::assume_aligned<alignment>(m_buffer);
+    }
+
+    /// Access the underlying buffer, in a mutable fashion.
+    ///
+    /// The pointer is declared to be aligned to \ref alignment bytes, so that
+    /// loops over it may be vectorized with aligned loads.
+    ///
+    /// \return Pointer to the first element, or \p nullptr if no storage has
+    /// been allocated.
+    value_type* data() { return std::assume_aligned<alignment>(m_buffer); }
+
     /// Access the first element, in a read-only fashion.
     ///
     /// This results in undefined behavior if this vector is empty.
@@ -194,19 +432,42 @@ public:
     /// \class iterator
     ///
     /// iterator for the \ref Vector class.
+    ///
+    /// Models \p std::contiguous_iterator, so that algorithms (and
+    /// \ref insert of a range) may operate on the underlying buffer directly.
     class iterator final
     {
+    public:
+        /// \typedef iterator_concept
+        ///
+        /// Elements are stored contiguously.
+        using iterator_concept = std::contiguous_iterator_tag;
+
+        /// \typedef iterator_category
+        ///
+        /// The legacy iterator category.
+        using iterator_category = std::random_access_iterator_tag;
+
         /// \typedef value_type
         ///
         /// The value type of element being iterated.
         using value_type = ValueT;
 
-        /// \typedef size_type
+        /// \typedef difference_type
         ///
-        /// The value type of the container size.
-        using size_type = std::size_t;
+        /// The signed distance between two iterators.
+        using difference_type = std::ptrdiff_t;
+
+        /// \typedef pointer
+        ///
+        /// Pointer to an element.
+        using pointer = value_type*;
+
+        /// \typedef reference
+        ///
+        /// Reference to an element.
+        using reference = value_type&;
 
-    public:
         /// Default constructor.
         iterator() = default;
 
@@ -225,45 +486,55 @@ public:
             return m_ptr == i_other.m_ptr;
         }
 
-        /// Check if the current position of the iterator matches another.
-        ///
-        /// \retval true If the positions do not match.
-        bool operator!=(const iterator& i_other) const
+        /// Compare the positions of this iterator and another.
+        auto operator<=>(const iterator& i_other) const
         {
-            return !(operator==(i_other));
+            return m_ptr <=> i_other.m_ptr;
         }
 
-        /// De-reference this iterator, returning value in a readable manner.
-        const value_type& operator*() const { return *m_ptr; }
+        /// De-reference this iterator.
+        reference operator*() const { return *m_ptr; }
 
-        /// De-reference this iterator, returning value in a writable manner.
-        value_type& operator*() { return *m_ptr; }
+        /// Access a member of the element at the current position.
+        pointer operator->() const { return m_ptr; }
+
+        /// Access the element \p count positions forward.
+        reference operator[](difference_type count) const
+        {
+            return m_ptr[count];
+        }
 
         /// Increment this iterator forwards.
-        const iterator& operator++()
+        iterator& operator++()
         {
             m_ptr++;
             return (*this);
         }
 
         /// Increment this iterator backwards.
-        const iterator& operator--()
+        iterator& operator--()
         {
             m_ptr--;
             return (*this);
         }
 
-        /// Increment this iterator forwards.
-        const iterator& operator++(int)
+        /// Increment this iterator forwards, returning its previous position.
+        iterator operator++(int) { return iterator(m_ptr++); }
+
+        /// Increment this iterator backwards, returning its previous position.
+        iterator operator--(int) { return iterator(m_ptr--); }
+
+        /// Move this iterator \p count positions forward.
+        iterator& operator+=(difference_type count)
         {
-            m_ptr++;
+            m_ptr += count;
             return (*this);
         }
 
-        /// Increment this iterator backwards.
-        const iterator& operator--(int)
+        /// Move this iterator \p count positions backwards.
+        iterator& operator-=(difference_type count)
         {
-            m_ptr--;
+            m_ptr -= count;
             return (*this);
         }
 
@@ -272,17 +543,30 @@ public:
         /// \param count The number of positions forward.
         ///
         /// \return New iterator.
-        iterator operator+(size_type count) { return iterator(m_ptr + count); }
+        iterator operator+(difference_type count) const
+        {
+            return iterator(m_ptr + count);
+        }
+
+        /// Create a new iterator which is \p count positions forward of
+        /// \p it.
+        friend iterator operator+(difference_type count, const iterator& it)
+        {
+            return it + count;
+        }
 
         /// Create a new iterator which is \p count positions backwards.
         ///
         /// \param count The number of positions backwards.
         ///
         /// \return New iterator.
-        iterator operator-(size_type count) { return iterator(m_ptr - count); }
+        iterator operator-(difference_type count) const
+        {
+            return iterator(m_ptr - count);
+        }
 
-        /// Increment this iterator backwards.
-        size_type operator-(const iterator& it) const
+        /// Compute the distance from \p it to this iterator.
+        difference_type operator-(const iterator& it) const
         {
             return m_ptr - it.m_ptr;
         }
@@ -356,6 +640,7 @@ public:
             m_buffer[index].~value_type();
         }
 
+        m_statistics.OnDestroy(m_size);
         m_size = 0;
     }
 
@@ -382,15 +667,24 @@ public:
         // Compute starting index
         size_type posIndex = position - begin();
 
-        // Perform reallocation and data migration (left & right ranges).
-        _ReallocForInsert(posIndex, count);
-
-        // Set values at insert locations.
-        for (size_t i = 0; i < count; ++i) {
-            m_buffer[posIndex + i] = value;
+        // The elements are shifted before the gap is filled, so a value
+        // which is one of them is copied out first.
+        if (std::less_equal<const value_type*>()(m_buffer, &value) &&
+            std::less<const value_type*>()(&value, m_buffer + m_size)) {
+            value_type copy(value);
+            return insert(position, count, copy);
         }
 
-        m_size += count;
+        // Open a gap at the insert location, and fill it with copies.
+        _InsertOps(
+            posIndex,
+            count,
+            [&](value_type* dst, size_type, size_type n) {
+                std::uninitialized_fill_n(dst, n, value);
+            },
+            [&](value_type* dst, size_type, size_type n) {
+                std::fill_n(dst, n, value);
+            });
 
         return iterator(m_buffer + posIndex);
     }
@@ -403,19 +697,7 @@ public:
     /// \return Position of the inserted element.
     iterator insert(iterator position, value_type&& value)
     {
-        // Compute starting index
-        size_type posIndex = position - begin();
-
-        // Perform reallocation and data migration (left & right ranges).
-        _ReallocForInsert(posIndex, 1);
-
-        // Set values at insert locations.
-        m_buffer[posIndex] = std::move(value);
-
-        // Increase size.
-        m_size += 1;
-
-        return iterator(m_buffer + posIndex);
+        return emplace(position, std::move(value));
     }
 
     /// Insert element at the specified location in the container.
@@ -426,22 +708,56 @@ public:
     /// \return Starting position of the inserted elements.
     iterator insert(iterator position,
                     std::initializer_list<value_type> initList)
+    {
+        return insert(position, initList.begin(), initList.end());
+    }
+
+    /// Insert a copy of each element in the range from \p first to \p last
+    /// at the specified location in the container.
+    ///
+    /// For forward iterators, the final size is computed up-front so that
+    /// storage is re-allocated at most once, and trivially copyable elements
+    /// from contiguous ranges are copied in a single block.
+    ///
+    /// The range must not point into this container.
+    ///
+    /// \param position The position to insert elements before.
+    /// \param first The first element in the range.
+    /// \param last The position after the last element in the range.
+    ///
+    /// \return Starting position of the inserted elements.
+    template<std::input_iterator IteratorT>
+    iterator insert(iterator position, IteratorT first, IteratorT last)
     {
         // Compute starting index
         size_type posIndex = position - begin();
 
-        // Perform reallocation and data migration (left & right ranges).
-        _ReallocForInsert(posIndex, initList.size());
-
-        // Set values at insert locations.
-        size_type offset = 0;
-        for (auto it = initList.begin(); it != initList.end(); ++it, ++offset) {
-            m_buffer[posIndex + offset] = *it;
+        if constexpr (std::forward_iterator<IteratorT>) {
+            size_type count = std::distance(first, last);
+
+            // Open a gap at the insert location, and fill it from the range.
+            _InsertOps(
+                posIndex,
+                count,
+                [&](value_type* dst, size_type offset, size_type n) {
+                    _ConstructRange(std::next(first, offset), n, dst);
+                },
+                [&](value_type* dst, size_type offset, size_type n) {
+                    std::copy_n(std::next(first, offset), n, dst);
+                });
+            m_statistics.OnCopy(sizeof(value_type) * count);
+        } else {
+            // The range can only be traversed once, so append each element
+            // then rotate them into place.
+            size_type oldSize = m_size;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(
+                m_buffer + posIndex, m_buffer + oldSize, m_buffer + m_size);
+            m_statistics.OnCopy(sizeof(value_type) * (m_size - posIndex));
         }
 
-        // Increase size.
-        m_size += initList.size();
-
         return iterator(m_buffer + posIndex);
     }
 
@@ -457,14 +773,18 @@ public:
         // Compute starting index
         size_type posIndex = position - begin();
 
-        // Perform reallocation and data migration (left & right ranges).
-        _ReallocForInsert(posIndex, 1);
-
-        // Construct in place at insertion position.
-        new (m_buffer + posIndex) value_type(std::forward<Args>(args)...);
-
-        // Increment size.
-        m_size += 1;
+        // Open a gap at the insert location.  The gap is un-initialized
+        // storage when appending or re-allocating, and otherwise holds a
+        // moved-from element, which is assigned a temporary.
+        _InsertOps(
+            posIndex,
+            1,
+            [&](value_type* dst, size_type, size_type) {
+                new (dst) value_type(std::forward<Args>(args)...);
+            },
+            [&](value_type* dst, size_type, size_type) {
+                *dst = value_type(std::forward<Args>(args)...);
+            });
 
         return iterator(m_buffer + posIndex);
     }
@@ -488,22 +808,94 @@ public:
         size_type posIndex = first - begin();
         size_type rangeSize = last - first;
 
-        // Shift range [position + 1, end) towards the left by 1, overwriting
-        // the element at position.
-        _CopyBuffer(m_buffer + posIndex + rangeSize,
-                    m_size - posIndex - rangeSize,
-                    m_buffer + posIndex,
-                    m_size - posIndex - rangeSize);
-
-        // Deconstruct last element.
-        m_buffer[m_size - rangeSize].~value_type();
+        if constexpr (IsTriviallyRelocatable<value_type>::value) {
+            // Deconstruct the erased elements, then shift range [last, end)
+            // over them in a single block move.
+            _DestroyBuffer(m_buffer + posIndex, rangeSize);
+            memmove(static_cast<void*>(m_buffer + posIndex),
+                    m_buffer + posIndex + rangeSize,
+                    sizeof(value_type) * (m_size - posIndex - rangeSize));
+        } else {
+            // Shift range [last, end) towards the left by rangeSize,
+            // move-assigning over the elements in the erased range.
+            std::move(m_buffer + posIndex + rangeSize,
+                      m_buffer + m_size,
+                      m_buffer + posIndex);
+
+            // Deconstruct the moved-from elements left at the tail.
+            for (size_type index = m_size - rangeSize; index < m_size;
+                 ++index) {
+                m_buffer[index].~value_type();
+            }
+        }
 
-        // Decrement size by 1.
+        // Decrement size by the number of erased elements.
+        m_statistics.OnCopy(sizeof(value_type) *
+                            (m_size - posIndex - rangeSize));
+        m_statistics.OnDestroy(rangeSize);
         m_size -= rangeSize;
 
         return iterator(m_buffer + posIndex);
     }
 
+    /// Erase the element at the specified \p position by moving the last
+    /// element into its place, in constant time.  The order of the remaining
+    /// elements is not preserved.
+    ///
+    /// \param position The position of the element to erase.
+    ///
+    /// \return The position of the erased element, which now holds the
+    /// former last element (or \ref end if the last element was erased).
+    iterator swap_erase(iterator position)
+    {
+        value_type* last = m_buffer + m_size - 1;
+        if (position.operator->() != last) {
+            *position = std::move(*last);
+            m_statistics.OnCopy(sizeof(value_type));
+        }
+
+        last->~value_type();
+        m_statistics.OnDestroy(1);
+        m_size--;
+
+        return position;
+    }
+
+    /// Erase all elements satisfying \p predicate, in a single pass which
+    /// moves each remaining element at most once.  The order of the
+    /// remaining elements is preserved.
+    ///
+    /// \param predicate Returns \p true for elements to erase.
+    ///
+    /// \return The number of erased elements.
+    template<typename PredicateT>
+    size_type erase_if(PredicateT predicate)
+    {
+        value_type* end = m_buffer + m_size;
+        value_type* dst = std::find_if(m_buffer, end, std::ref(predicate));
+        if (dst == end) {
+            return 0;
+        }
+
+        // Compact the remaining elements towards the front.
+        value_type* firstDst = dst;
+        for (value_type* src = dst + 1; src != end; ++src) {
+            if (!predicate(*src)) {
+                *dst = std::move(*src);
+                ++dst;
+            }
+        }
+
+        // Deconstruct the moved-from elements left at the tail.
+        size_type erasedCount = end - dst;
+        _DestroyBuffer(dst, erasedCount);
+        m_statistics.OnCopy(sizeof(value_type) * (dst - firstDst));
+        m_statistics.OnDestroy(erasedCount);
+        m_size -= erasedCount;
+
+        return erasedCount;
+    }
+
     /// Appends an element to the end of the container.
     ///
     /// \param value The element value.
@@ -514,13 +906,11 @@ public:
             _Realloc(_NextCapacity(1));
         }
 
-        // Initialize the element at the end.
-        new (m_buffer + m_size) value_type();
-
-        // Copy value into element at end.
-        m_buffer[m_size] = value;
+        // Copy-construct the element at the end.
+        new (m_buffer + m_size) value_type(value);
 
         // Increase size by 1.
+        m_statistics.OnConstruct(1);
         m_size++;
     }
 
@@ -534,16 +924,48 @@ public:
             _Realloc(_NextCapacity(1));
         }
 
-        // Initialize the element at the end.
-        new (m_buffer + m_size) value_type();
-
-        // Move value into buffer.
-        m_buffer[m_size] = std::move(value);
+        // Move-construct the element at the end.
+        new (m_buffer + m_size) value_type(std::move(value));
 
         // Increase size by 1.
+        m_statistics.OnConstruct(1);
         m_size++;
     }
 
+    /// Appends a copy of each element in \p range to the end of the
+    /// container.
+    ///
+    /// For forward ranges, the final size is computed up-front so that
+    /// storage is re-allocated at most once, and trivially copyable elements
+    /// from contiguous ranges are copied in a single block.
+    ///
+    /// \param range The range of elements to append.
+    template<std::ranges::input_range RangeT>
+    void append_range(RangeT&& range)
+    {
+        if constexpr (std::ranges::forward_range<RangeT>) {
+            size_type count = std::ranges::distance(range);
+
+            // Allocate more memory if required.
+            if (m_size + count > m_capacity) {
+                _Realloc(_NextCapacity(count));
+            }
+
+            // Construct the elements at the end.
+            _ConstructRange(
+                std::ranges::begin(range), count, m_buffer + m_size);
+
+            // Increase size by count.
+            m_statistics.OnConstruct(count);
+            m_statistics.OnCopy(sizeof(value_type) * count);
+            m_size += count;
+        } else {
+            for (auto&& value : range) {
+                emplace_back(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
     /// Constructs a new element at the end of the container.
     ///
     /// \param value The element value.
@@ -560,6 +982,7 @@ public:
             new (m_buffer + m_size) value_type(std::forward<Args>(args)...);
 
         // Increase size by 1.
+        m_statistics.OnConstruct(1);
         m_size++;
 
         // Return the newly allocated element.
@@ -572,13 +995,36 @@ public:
     void pop_back()
     {
         m_buffer[m_size - 1].~value_type();
+        m_statistics.OnDestroy(1);
         m_size--;
     }
 
     /// Resize the vector to contain \p count number of elements.
     ///
     /// \param count The number of elements.
-    void resize(size_type count) { _ResizeOps(count, _NoOp, _NoOp); }
+    void resize(size_type count)
+    {
+        _ResizeOps(
+            count,
+            [&](size_type index) { new (m_buffer + index) value_type(); },
+            _NoOp);
+    }
+
+    /// Resize the vector to contain \p count number of elements, appending
+    /// default-initialized elements when the vector increases in size.
+    ///
+    /// For trivial types, new elements are left with indeterminate values
+    /// and only the size is adjusted.  Use this when the caller overwrites
+    /// every new element immediately afterwards.
+    ///
+    /// \param count The number of elements.
+    void resize(size_type count, DefaultInitT)
+    {
+        _ResizeOps(
+            count,
+            [&](size_type index) { new (m_buffer + index) value_type; },
+            _NoOp);
+    }
 
     /// Resize the vector to contain \p count number of elements, appending
     /// default-initialized \p value when the vector increases in size.
@@ -589,106 +1035,224 @@ public:
     {
         _ResizeOps(
             count,
-            [&](void) {
-                for (size_type index = m_size; index < count; ++index) {
-                    m_buffer[index] = value;
-                }
-            },
+            [&](size_type index) { new (m_buffer + index) value_type(value); },
             _NoOp);
     }
 
-    /// Swaps the contents with the \p other vector.
+    /// Swaps the contents with the \p other vector.  Inline storage is
+    /// swapped by moving the elements, which may throw.
     ///
     /// \param other The other vector.
-    void swap(Vector& other) noexcept
+    void swap(Vector& other) noexcept(_IsNothrowMovable())
     {
-        std::swap(m_capacity, other.m_capacity);
-        std::swap(m_size, other.m_size);
-        std::swap(m_buffer, other.m_buffer);
+        if constexpr (InlineStorageAllocator<allocator_type>) {
+            // Inline storage cannot change owners, so go through moves.
+            if (m_allocator.is_inline(m_buffer) ||
+                other.m_allocator.is_inline(other.m_buffer)) {
+                Vector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+                return;
+            }
+        }
+
+        if constexpr (_AllocatorTraits::propagate_on_container_swap::value) {
+            std::swap(m_allocator, other.m_allocator);
+        }
+        _SwapStorage(other);
     }
 
+    /// Get a copy of the allocator used by this vector.
+    ///
+    /// \return The allocator.
+    allocator_type get_allocator() const { return m_allocator; }
+
+protected:
+    // Access the allocator in place, for derived containers whose allocator
+    // holds state which is not carried over by copies (see SmallVector).
+    const allocator_type& _GetAllocator() const { return m_allocator; }
+
 private:
+    using _AllocatorTraits = std::allocator_traits<allocator_type>;
+
     static void _NoOp() {}
 
-    // Perform memory allocation and data migration for a insert operation.
-    void _ReallocForInsert(size_type posIndex, size_type count)
+    // Exchange buffers (but not allocators) with \p other.
+    void _SwapStorage(Vector& other) noexcept
     {
-        // Allocate more memory if required.
-        value_type* targetBuffer = nullptr;
-        if (m_size + count > m_capacity) {
-            size_type elementsToAlloc = _NextCapacity(count);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_buffer, other.m_buffer);
+    }
 
-            // Create a new allocation.
-            targetBuffer = _Alloc(elementsToAlloc);
+    // Whether moving the contents of a vector cannot throw: only elements in
+    // inline storage, which cannot change owners, are moved one by one.
+    static constexpr bool _IsNothrowMovable()
+    {
+        return !InlineStorageAllocator<allocator_type> ||
+               std::is_nothrow_move_constructible_v<value_type>;
+    }
 
-            // Initialize full range due to new allocation.
-            for (size_type index = 0; index < m_size + count; ++index) {
-                new (targetBuffer + index) value_type();
+    // Check if the buffer of \p src can be freed by this vector's allocator,
+    // and therefore adopted without moving elements.
+    bool _CanAdoptStorage(const Vector& src) const
+    {
+        if constexpr (InlineStorageAllocator<allocator_type>) {
+            if (src.m_allocator.is_inline(src.m_buffer)) {
+                return false;
             }
-        } else {
-            targetBuffer = m_buffer;
+        }
 
-            // Initialize extended range.
-            for (size_type index = m_size; index < m_size + count; ++index) {
-                new (targetBuffer + index) value_type();
-            }
+        return m_allocator == src.m_allocator;
+    }
+
+    // Replace the contents of this vector by moving the elements of \p src
+    // individually, leaving \p src empty.
+    void _MoveElementsFrom(Vector& src)
+    {
+        clear();
+        reserve(src.m_size);
+        _MoveConstructBuffer(src.m_buffer, src.m_size, m_buffer);
+        m_statistics.OnConstruct(src.m_size);
+        m_statistics.OnCopy(sizeof(value_type) * src.m_size);
+        m_size = src.m_size;
+        src.clear();
+    }
+
+    // Procedure for an insert of \p count elements at \p posIndex, opening a
+    // gap for them by shifting the right range, then filling it.  Slots of
+    // the gap in un-initialized storage are filled by \p constructOp, and
+    // slots holding moved-from elements by \p assignOp.  Each is called with
+    // the first slot, its offset into the inserted elements, and the number
+    // of slots, and \p constructOp must destroy what it constructed should
+    // it throw.
+    //
+    // Should an element operation throw, every element in [0, m_size) is
+    // left alive, and every other element is destroyed.
+    template<typename ConstructOp, typename AssignOp>
+    void _InsertOps(size_type posIndex,
+                    size_type count,
+                    ConstructOp constructOp,
+                    AssignOp assignOp)
+    {
+        if (count == 0) {
+            return;
         }
 
-        // Perform buffer migration is necessary.
-        if (m_buffer != nullptr) {
-            // Migrate left range.
-            if (posIndex != 0) {
-                _CopyBuffer(m_buffer, posIndex, targetBuffer, posIndex);
+        size_type rightCount = m_size - posIndex;
+
+        if constexpr (IsTriviallyRelocatable<value_type>::value) {
+            // Grow the existing allocation, then open up the gap by shifting
+            // the right range in a single block move.
+            if (m_size + count > m_capacity) {
+                _Realloc(_NextCapacity(count));
             }
 
-            // Migrate right range.
-            if (m_size - posIndex != 0) {
-                _CopyBufferReversed(m_buffer + posIndex,
-                                    m_size - posIndex,
-                                    targetBuffer + count + posIndex,
-                                    m_size - posIndex);
+            value_type* gap = m_buffer + posIndex;
+            if (rightCount != 0) {
+                memmove(static_cast<void*>(gap + count),
+                        gap,
+                        sizeof(value_type) * rightCount);
             }
 
-            // If targetBuffer is a new allocation...
-            if (targetBuffer != m_buffer) {
-                // De-construct elements in old buffer.
-                for (size_type index = 0; index < m_size; ++index) {
-                    m_buffer[index].~value_type();
+            try {
+                constructOp(gap, 0, count);
+            } catch (...) {
+                // Close the gap again, leaving the vector unchanged.
+                if (rightCount != 0) {
+                    memmove(static_cast<void*>(gap),
+                            gap + count,
+                            sizeof(value_type) * rightCount);
                 }
+                throw;
+            }
+        } else if (m_size + count > m_capacity) {
+            // Construct the inserted elements into a new allocation, then
+            // migrate the left & right ranges around them.  The elements are
+            // intact in the old buffer until it is released, so a throw only
+            // undoes the new one.
+            AllocationResult<value_type*> allocation =
+                _Alloc(_NextCapacity(count));
+            value_type* gap = allocation.ptr + posIndex;
+            try {
+                constructOp(gap, 0, count);
+            } catch (...) {
+                _Free(allocation.ptr, allocation.count);
+                throw;
+            }
 
-                // Free old allocation.
-                free(m_buffer);
-
-                // Upgrade to new buffer.
-                m_buffer = targetBuffer;
+            size_type leftCount = 0;
+            try {
+                _MoveConstructBuffer(m_buffer, posIndex, allocation.ptr);
+                leftCount = posIndex;
+                _MoveConstructBuffer(
+                    m_buffer + posIndex, rightCount, gap + count);
+            } catch (...) {
+                _DestroyBuffer(allocation.ptr, leftCount);
+                _DestroyBuffer(gap, count);
+                _Free(allocation.ptr, allocation.count);
+                throw;
+            }
+            _DestroyBuffer(m_buffer, m_size);
+            _Free(m_buffer, m_capacity);
+            m_statistics.OnReallocate(sizeof(value_type) * allocation.count);
+            m_statistics.OnConstruct(m_size);
+            m_statistics.OnDestroy(m_size);
+
+            m_buffer = allocation.ptr;
+            m_capacity = allocation.count;
+        } else if (count <= rightCount) {
+            // The last count elements of the right range move past the end,
+            // and the rest of it shifts over the gap, which is left holding
+            // moved-from elements.
+            _MoveConstructBuffer(
+                m_buffer + m_size - count, count, m_buffer + m_size);
+            m_statistics.OnConstruct(count);
+            m_size += count;
+            std::move_backward(m_buffer + posIndex,
+                               m_buffer + m_size - 2 * count,
+                               m_buffer + m_size - count);
+            assignOp(m_buffer + posIndex, 0, count);
+            m_statistics.OnCopy(sizeof(value_type) * rightCount);
+            return;
+        } else {
+            // The whole right range moves past the end, leaving moved-from
+            // elements at the start of the gap and un-initialized storage at
+            // its end.
+            value_type* gap = m_buffer + posIndex;
+            _MoveConstructBuffer(gap, rightCount, gap + count);
+            try {
+                constructOp(m_buffer + m_size, rightCount, count - rightCount);
+            } catch (...) {
+                _DestroyBuffer(gap + count, rightCount);
+                throw;
             }
+            m_statistics.OnConstruct(count);
+            m_size += count;
+            assignOp(gap, 0, rightCount);
+            m_statistics.OnCopy(sizeof(value_type) * rightCount);
+            return;
         }
+
+        m_statistics.OnConstruct(count);
+        m_statistics.OnCopy(sizeof(value_type) * rightCount);
+        m_size += count;
     }
 
     // Computes a new capacity to contain an additional \p count number of
     // elements being inserted into this container.
     size_type _NextCapacity(size_type count)
     {
-        // Compute base capacity value.
-        size_type nextCapacity = m_capacity;
-        if (nextCapacity == 0) {
-            nextCapacity = 1;
-        }
-
-        // Increase by multipliers of 2 until it can accomodate the insertion.
-        while (count + m_size > nextCapacity) {
-            nextCapacity *= 2;
-        }
-
-        return nextCapacity;
+        return growth_policy_type::NextCapacity(
+            m_capacity, m_size + count, sizeof(value_type));
     }
 
-    // Procedure for performing a resize, then an operation against newly
-    // initialized elements, as well as another operation against all elements.
+    // Procedure for performing a resize, constructing each new element with
+    // \p constructOp, then running another operation against all elements.
     // This reduces the logic duplication of callers.
-    template<typename NewElementsOp, typename AllElementsOp>
+    template<typename ConstructOp, typename AllElementsOp>
     void _ResizeOps(size_type count,
-                    NewElementsOp newElementsOp,
+                    ConstructOp constructOp,
                     AllElementsOp allElementsOp)
     {
         // Perform buffer re-allocation if required.
@@ -697,18 +1261,18 @@ private:
         }
 
         if (count > m_size) {
-            // Call constructor on new, un-initialized elements.
+            // Run caller-specified construction on new, un-initialized
+            // elements.
             for (size_type index = m_size; index < count; ++index) {
-                new (m_buffer + index) value_type();
+                constructOp(index);
             }
-
-            // Run caller-specified operation on new elements.
-            newElementsOp();
+            m_statistics.OnConstruct(count - m_size);
         } else if (count < m_size) {
             // Run de-constructor on elements removed due to down-sizing.
             for (size_type index = count; index < m_size; ++index) {
                 m_buffer[index].~value_type();
             }
+            m_statistics.OnDestroy(m_size - count);
         }
 
         // Perform an operation on all the elements.
@@ -720,26 +1284,56 @@ private:
     // Shared functionality for copying a source Vector to this one.
     void _CopyFrom(const Vector& src)
     {
-        _ResizeOps(src.m_size, _NoOp, [&](void) {
-            _CopyBuffer(src.m_buffer, src.m_size, m_buffer, src.m_size);
-        });
+        // Existing elements are copy-assigned, new ones are copy-constructed.
+        size_type assignCount = std::min(m_size, src.m_size);
+        _ResizeOps(
+            src.m_size,
+            [&](size_type index) {
+                new (m_buffer + index) value_type(src.m_buffer[index]);
+            },
+            [&](void) {
+                _CopyBuffer(src.m_buffer, assignCount, m_buffer, assignCount);
+            });
+        m_statistics.OnCopy(sizeof(value_type) * src.m_size);
     }
 
     // Shared functionality for copying a source Vector to this one.
     void _CopyFromInitList(const std::initializer_list<value_type>& src)
     {
-        _ResizeOps(src.size(), _NoOp, [&](void) {
-            size_type index = 0;
-            for (auto it = src.begin(); it != src.end(); ++it, ++index) {
-                m_buffer[index] = *it;
-            }
-        });
+        // Existing elements are copy-assigned, new ones are copy-constructed.
+        size_type assignCount = std::min(m_size, src.size());
+        _ResizeOps(
+            src.size(),
+            [&](size_type index) {
+                new (m_buffer + index) value_type(src.begin()[index]);
+            },
+            [&](void) {
+                for (size_type index = 0; index < assignCount; ++index) {
+                    m_buffer[index] = src.begin()[index];
+                }
+            });
+        m_statistics.OnCopy(sizeof(value_type) * src.size());
     }
 
-    // Allocate a block of memory containing \p count elements.
-    static value_type* _Alloc(size_type count)
+    // Allocate a block of memory containing at least \p count elements.
+    AllocationResult<value_type*> _Alloc(size_type count)
     {
-        return static_cast<value_type*>(malloc(sizeof(value_type) * count));
+        AllocationResult<value_type*> allocation;
+        if constexpr (AtLeastAllocator<allocator_type>) {
+            allocation = m_allocator.allocate_at_least(count);
+        } else {
+            allocation = { _AllocatorTraits::allocate(m_allocator, count),
+                           count };
+        }
+
+        m_statistics.OnAllocate(sizeof(value_type) * allocation.count);
+        return allocation;
+    }
+
+    // Free a block of memory containing \p count elements.
+    void _Free(value_type* buffer, size_type count)
+    {
+        _AllocatorTraits::deallocate(m_allocator, buffer, count);
     }
 
     // Create a new allocation to contain \p count elements.
@@ -748,32 +1342,97 @@ private:
     // The old elements are deconstructed and their buffer destroyed.
     void _Realloc(size_type count)
     {
-        // Create a new allocation.
-        value_type* newBuffer = _Alloc(count);
+        if constexpr (InlineStorageAllocator<allocator_type>) {
+            // Inline storage always spans the full inline capacity, so there
+            // is nothing to do for requests which still fit.
+            if (m_allocator.is_inline(m_buffer) &&
+                count <= allocator_type::inline_capacity) {
+                return;
+            }
+        }
 
-        if (m_buffer != nullptr) {
-            // Perform initialization on existing elements (in new buffer).
-            for (size_type index = 0; index < m_size; ++index) {
-                new (newBuffer + index) value_type();
+        if constexpr (IsTriviallyRelocatable<value_type>::value &&
+                      ReallocatableAllocator<allocator_type>) {
+            // Elements can be relocated bytewise, so let the allocator grow or
+            // shrink the block in-place if it is able to.
+            bool hadBuffer = m_buffer != nullptr;
+            m_buffer = m_allocator.reallocate(m_buffer, m_capacity, count);
+            m_capacity = count;
+            if (hadBuffer) {
+                m_statistics.OnReallocate(sizeof(value_type) * count);
+            } else {
+                m_statistics.OnAllocate(sizeof(value_type) * count);
             }
+            return;
+        }
 
-            // Copy existing elements into new buffer.
-            _CopyBuffer(m_buffer, m_size, newBuffer, count);
+        // Create a new allocation.
+        AllocationResult<value_type*> allocation = _Alloc(count);
 
-            // De-construct elements in old buffer.
-            for (size_type index = 0; index < m_size; ++index) {
-                m_buffer[index].~value_type();
+        if (m_buffer != nullptr) {
+            // Migrate existing elements into the new buffer, with a single
+            // copy if they can be relocated bytewise.
+            size_type migrateCount = std::min(m_size, count);
+            if constexpr (IsTriviallyRelocatable<value_type>::value) {
+                memcpy(static_cast<void*>(allocation.ptr),
+                       m_buffer,
+                       sizeof(value_type) * migrateCount);
+            } else {
+                // Should an element copy throw, the elements are intact in
+                // the old buffer, so only the new one is released.
+                try {
+                    _MoveConstructBuffer(
+                        m_buffer, migrateCount, allocation.ptr);
+                } catch (...) {
+                    _Free(allocation.ptr, allocation.count);
+                    throw;
+                }
+
+                // De-construct elements in old buffer.
+                _DestroyBuffer(m_buffer, m_size);
+                m_statistics.OnConstruct(migrateCount);
+                m_statistics.OnDestroy(m_size);
             }
 
             // Free old allocation.
-            free(m_buffer);
+            _Free(m_buffer, m_capacity);
+            m_statistics.OnReallocate(sizeof(value_type) * allocation.count);
+            m_statistics.OnCopy(sizeof(value_type) * migrateCount);
         }
 
         // Assign new buffer ptr.
-        m_buffer = newBuffer;
+        m_buffer = allocation.ptr;
 
         // Update allocation size.
-        m_capacity = count;
+        m_capacity = allocation.count;
+    }
+
+    // Copy-construct \p count elements from the range starting at \p first
+    // into the un-initialized storage at \p dst.  Should a copy throw, the
+    // elements already constructed are destroyed.
+    template<typename IteratorT>
+    static void _ConstructRange(IteratorT first,
+                                size_type count,
+                                value_type* dst)
+    {
+        if constexpr (std::contiguous_iterator<IteratorT> &&
+                      std::is_trivially_copyable<value_type>::value &&
+                      std::is_same<std::iter_value_t<IteratorT>,
+                                   value_type>::value) {
+            if (count != 0) {
+                memcpy(dst, std::to_address(first), sizeof(value_type) * count);
+            }
+        } else {
+            size_type index = 0;
+            try {
+                for (; index < count; ++index, ++first) {
+                    new (dst + index) value_type(*first);
+                }
+            } catch (...) {
+                _DestroyBuffer(dst, index);
+                throw;
+            }
+        }
     }
 
     // Copy elements from one buffer to another.
@@ -783,20 +1442,42 @@ private:
                             size_type dstSize)
     {
         size_type copyCount = std::min(srcSize, dstSize);
-        for (size_type i = 0; i < copyCount; ++i) {
-            dstBuffer[i] = srcBuffer[i];
+        if constexpr (std::is_trivially_copyable_v<value_type>) {
+            memcpy(dstBuffer, srcBuffer, sizeof(value_type) * copyCount);
+        } else {
+            for (size_type i = 0; i < copyCount; ++i) {
+                dstBuffer[i] = srcBuffer[i];
+            }
         }
     }
 
-    // Copy elements from one buffer to another in reversed order.
-    static void _CopyBufferReversed(value_type* srcBuffer,
-                                    size_type srcSize,
-                                    value_type* dstBuffer,
-                                    size_type dstSize)
+    // Construct \p count elements into the un-initialized \p dstBuffer from
+    // \p srcBuffer, moving them if the move constructor cannot throw and
+    // copying them otherwise (so that a throwing copy leaves the source
+    // intact).
+    static void _MoveConstructBuffer(value_type* srcBuffer,
+                                     size_type count,
+                                     value_type* dstBuffer)
     {
-        size_type copyCount = std::min(srcSize, dstSize);
-        for (size_type i = copyCount; i > 0; --i) {
-            dstBuffer[i - 1] = srcBuffer[i - 1];
+        size_type index = 0;
+        try {
+            for (; index < count; ++index) {
+                new (dstBuffer + index)
+                    value_type(std::move_if_noexcept(srcBuffer[index]));
+            }
+        } catch (...) {
+            _DestroyBuffer(dstBuffer, index);
+            throw;
+        }
+    }
+
+    // Deconstruct \p count elements in \p buffer.
+    static void _DestroyBuffer(value_type* buffer, size_type count)
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (size_type index = 0; index < count; ++index) {
+                buffer[index].~value_type();
+            }
         }
     }
 
@@ -808,9 +1489,10 @@ private:
             for (size_type index = 0; index < m_size; ++index) {
                 m_buffer[index].~value_type();
             }
+            m_statistics.OnDestroy(m_size);
 
             // Free buffer.
-            free(m_buffer);
+            _Free(m_buffer, m_capacity);
 
             m_buffer = nullptr;
             m_size = 0;
@@ -827,4 +1509,49 @@ private:
 
     // Pointer to the allocated buffer.
     value_type* m_buffer = nullptr;
+
+    // Allocator used to obtain the buffer.
+    [[no_unique_address]] allocator_type m_allocator;
+
+    // Records storage operations.
+    [[no_unique_address]] statistics_type m_statistics;
 };
+
+/// Erase all elements of \p vec satisfying \p predicate, mirroring
+/// \p std::erase_if.  See \ref Vector::erase_if.
+///
+/// \param vec The vector to erase from.
+/// \param predicate Returns \p true for elements to erase.
+///
+/// \return The number of erased elements.
+template<typename ValueT,
+         typename AllocatorT,
+         typename GrowthPolicyT,
+         typename StatisticsT,
+         typename PredicateT>
+std::size_t
+erase_if(Vector<ValueT, AllocatorT, GrowthPolicyT, StatisticsT>& vec,
+         PredicateT predicate)
+{
+    return vec.erase_if(predicate);
+}
+
+/// \typedef AlignedVector
+///
+/// A \ref Vector whose storage is aligned to \p AlignmentV bytes, such as 32
+/// for AVX or 64 for AVX-512 and cache lines.
+///
+/// \tparam ValueT The type of each element.
+/// \tparam AlignmentV The alignment of the storage, in bytes.
+template<typename ValueT, std::size_t AlignmentV>
+using AlignedVector = Vector<ValueT, MallocAllocator<ValueT, AlignmentV>>;
+
+namespace pmr {
+
+/// \typedef Vector
+///
+/// A \ref ::Vector which allocates from a \p std::pmr::memory_resource.
+template<typename ValueT>
+using Vector = ::Vector<ValueT, std::pmr::polymorphic_allocator<ValueT>>;
+
+} // namespace pmr
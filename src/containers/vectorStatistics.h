@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Statistics policies observe the storage operations of a \ref Vector, and
+// are supplied as its \p StatisticsT parameter.  Each is constructed from the
+// source location of the statement constructing the vector, which identifies
+// its call site.
+
+/// \class NoVectorStatistics
+///
+/// Statistics policy which records nothing.  It is empty, and each of its
+/// hooks compiles away, so that un-instrumented vectors pay nothing for it.
+struct NoVectorStatistics
+{
+    constexpr explicit NoVectorStatistics(const std::source_location&) noexcept
+    {}
+
+    void OnAllocate(std::size_t) noexcept {}
+    void OnReallocate(std::size_t) noexcept {}
+    void OnCopy(std::size_t) noexcept {}
+    void OnConstruct(std::size_t) noexcept {}
+    void OnDestroy(std::size_t) noexcept {}
+};
+
+/// \class VectorSiteStatistics
+///
+/// Totals of the storage operations of every vector constructed at one call
+/// site.
+struct VectorSiteStatistics
+{
+    /// The call site, as "file:line (function)".
+    std::string site;
+
+    /// Number of buffers obtained from the allocator.
+    std::atomic<std::uint64_t> allocations = 0;
+
+    /// Number of times existing elements were moved to a resized buffer.
+    std::atomic<std::uint64_t> reallocations = 0;
+
+    /// Number of bytes of elements copied or moved by the container: when
+    /// re-allocating, when shifting elements on insertion or erasure, and
+    /// when copying from other containers or ranges.  Copies made within an
+    /// allocator's \p reallocate are not visible, and not counted.
+    std::atomic<std::uint64_t> bytesCopied = 0;
+
+    /// Number of elements constructed, including by re-allocation.
+    std::atomic<std::uint64_t> elementsConstructed = 0;
+
+    /// Number of elements destroyed, including by re-allocation.
+    std::atomic<std::uint64_t> elementsDestroyed = 0;
+
+    /// The largest buffer held by a single vector, in bytes.
+    std::atomic<std::uint64_t> peakCapacityBytes = 0;
+};
+
+/// \class VectorStatisticsRegistry
+///
+/// Process-wide registry of \ref VectorSiteStatistics, by call site.
+class VectorStatisticsRegistry
+{
+public:
+    /// Get the registry.  It is never destroyed, so that vectors destroyed
+    /// during static de-initialization may still record into it.
+    static VectorStatisticsRegistry& Get()
+    {
+        static VectorStatisticsRegistry* registry =
+            new VectorStatisticsRegistry();
+        return *registry;
+    }
+
+    /// Get the statistics of the call site at \p location, adding them if
+    /// they do not exist.
+    ///
+    /// \param location The call site.
+    ///
+    /// \return The statistics, whose address is stable.
+    VectorSiteStatistics& FindOrAdd(const std::source_location& location)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto [it, inserted] = m_sites.try_emplace(
+            _Key(location.file_name(), location.line(), location.column()));
+        if (inserted) {
+            it->second.site = std::string(location.file_name()) + ":" +
+                              std::to_string(location.line()) + " (" +
+                              location.function_name() + ")";
+        }
+        return it->second;
+    }
+
+    /// Invoke \p fn with the statistics of each call site.
+    ///
+    /// \param fn Receives a const \ref VectorSiteStatistics reference.
+    template<typename FnT>
+    void ForEachSite(FnT&& fn) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& [key, statistics] : m_sites) {
+            fn(statistics);
+        }
+    }
+
+    /// Zero the statistics of every call site.
+    void Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [key, statistics] : m_sites) {
+            statistics.allocations = 0;
+            statistics.reallocations = 0;
+            statistics.bytesCopied = 0;
+            statistics.elementsConstructed = 0;
+            statistics.elementsDestroyed = 0;
+            statistics.peakCapacityBytes = 0;
+        }
+    }
+
+    /// Print a table of the statistics of every call site to \p stream,
+    /// ordered by decreasing bytes copied.
+    ///
+    /// \param stream The output stream.
+    void Dump(FILE* stream) const
+    {
+        std::vector<const VectorSiteStatistics*> sites;
+        ForEachSite([&](const VectorSiteStatistics& statistics) {
+            sites.push_back(&statistics);
+        });
+        std::sort(sites.begin(), sites.end(), [](auto* lhs, auto* rhs) {
+            return lhs->bytesCopied > rhs->bytesCopied;
+        });
+
+        fprintf(stream,
+                "%12s %12s %14s %14s %14s %14s  %s\n",
+                "allocs",
+                "reallocs",
+                "bytes copied",
+                "constructed",
+                "destroyed",
+                "peak bytes",
+                "site");
+        for (const VectorSiteStatistics* statistics : sites) {
+            fprintf(stream,
+                    "%12llu %12llu %14llu %14llu %14llu %14llu  %s\n",
+                    _Load(statistics->allocations),
+                    _Load(statistics->reallocations),
+                    _Load(statistics->bytesCopied),
+                    _Load(statistics->elementsConstructed),
+                    _Load(statistics->elementsDestroyed),
+                    _Load(statistics->peakCapacityBytes),
+                    statistics->site.c_str());
+        }
+    }
+
+    /// Dump the statistics to \p stream when the program exits.
+    ///
+    /// \param stream The output stream.
+    void DumpAtExit(FILE* stream = stderr)
+    {
+        static std::once_flag registered;
+        s_exitStream = stream;
+        std::call_once(registered, [] {
+            std::atexit([] { Get().Dump(s_exitStream); });
+        });
+    }
+
+private:
+    // File, line and column of a call site.
+    using _Key =
+        std::tuple<std::string, std::uint_least32_t, std::uint_least32_t>;
+
+    VectorStatisticsRegistry() = default;
+
+    static unsigned long long _Load(const std::atomic<std::uint64_t>& value)
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+    static inline std::atomic<FILE*> s_exitStream = nullptr;
+
+    mutable std::mutex m_mutex;
+
+    // Node-based, so that statistics never move.
+    std::map<_Key, VectorSiteStatistics> m_sites;
+};
+
+/// \class VectorStatistics
+///
+/// Statistics policy which records into the \ref VectorStatisticsRegistry
+/// entry of the call site constructing the vector.  The entry is looked up
+/// on the first recorded operation rather than on construction, so that
+/// constructing a vector does not lock the registry.
+class VectorStatistics
+{
+public:
+    explicit VectorStatistics(const std::source_location& location) noexcept
+      : m_location(location)
+    {}
+
+    void OnAllocate(std::size_t bytes)
+    {
+        VectorSiteStatistics& site = _Site();
+        site.allocations.fetch_add(1, std::memory_order_relaxed);
+        _UpdatePeak(site, bytes);
+    }
+
+    void OnReallocate(std::size_t bytes)
+    {
+        VectorSiteStatistics& site = _Site();
+        site.reallocations.fetch_add(1, std::memory_order_relaxed);
+        _UpdatePeak(site, bytes);
+    }
+
+    void OnCopy(std::size_t bytes)
+    {
+        _Site().bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    void OnConstruct(std::size_t count)
+    {
+        _Site().elementsConstructed.fetch_add(count,
+                                              std::memory_order_relaxed);
+    }
+
+    void OnDestroy(std::size_t count)
+    {
+        _Site().elementsDestroyed.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+    VectorSiteStatistics& _Site()
+    {
+        if (m_site == nullptr) {
+            m_site = &VectorStatisticsRegistry::Get().FindOrAdd(m_location);
+        }
+        return *m_site;
+    }
+
+    static void _UpdatePeak(VectorSiteStatistics& site, std::size_t bytes)
+    {
+        std::uint64_t peak =
+            site.peakCapacityBytes.load(std::memory_order_relaxed);
+        while (peak < bytes && !site.peakCapacityBytes.compare_exchange_weak(
+                                   peak, bytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::source_location m_location;
+    VectorSiteStatistics* m_site = nullptr;
+};
+
+/// \typedef DefaultVectorStatistics
+///
+/// The statistics policy of \ref Vector when none is specified: recording
+/// when \p CONTAINERS_VECTOR_STATISTICS is defined, and nothing otherwise.
+/// The definition must be consistent across a program.
+#ifdef CONTAINERS_VECTOR_STATISTICS
+using DefaultVectorStatistics = VectorStatistics;
+#else
+using DefaultVectorStatistics = NoVectorStatistics;
+#endif
@@ -4,9 +4,12 @@
 #include <string>
 #include <unordered_map>
 
+#include <hashMap.h>
+
 #include "utils.h"
 
 using SerialHashMapT = std::unordered_map<std::string, std::string>;
+using OpenHashMapT = HashMap<std::string, std::string>;
 using ConcurrentHashMapT = tbb::concurrent_hash_map<std::string, std::string>;
 
 template<typename HashMapT>
@@ -28,6 +31,18 @@ static SerialHashMapT SerialHashMap(size_t numElements)
     return hashMap;
 }
 
+static OpenHashMapT OpenHashMap(size_t numElements)
+{
+    PROFILE_FUNCTION();
+
+    OpenHashMapT hashMap;
+    for (size_t i = 0; i < numElements; ++i) {
+        InsertValue(i, hashMap);
+    }
+
+    return hashMap;
+}
+
 static ConcurrentHashMapT ConcurrentHashMap(size_t numElements)
 {
     PROFILE_FUNCTION();
@@ -50,19 +65,22 @@ int main(int argc, char** argv)
         return EXIT_FAILURE;
     }
 
-    int numElements = DeserializeValue<int>(argv[1]);
+    size_t numElements = DeserializeValue<size_t>(argv[1]);
 
-    // Run both serial and concurrent maps on equal data.
+    // Run the serial, open-addressing and concurrent maps on equal data.
     SerialHashMapT serialHashMap = SerialHashMap(numElements);
+    OpenHashMapT openHashMap = OpenHashMap(numElements);
     ConcurrentHashMapT concurrentHashMap = ConcurrentHashMap(numElements);
 
     // Validate results.
     ASSERT(serialHashMap.size() == numElements);
+    ASSERT(openHashMap.size() == numElements);
     ASSERT(concurrentHashMap.size() == numElements);
     ConcurrentHashMapT::const_accessor constAccessor;
     for (const SerialHashMapT::value_type& item : serialHashMap) {
         ASSERT(concurrentHashMap.find(constAccessor, item.first));
         ASSERT(item.second == constAccessor->second);
+        ASSERT(openHashMap.at(item.first) == item.second);
     }
 
     return EXIT_SUCCESS;
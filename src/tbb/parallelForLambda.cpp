@@ -3,6 +3,8 @@
 #include <stdio.h>
 #include <vector>
 
+#include <vector.h>
+
 #include "utils.h"
 
 static int Computation(int a, int b, int c)
@@ -29,6 +31,35 @@ static void ParallelFor(std::vector<int>& array)
                       });
 }
 
+// Output buffers are fully overwritten by the loop, so any initialization
+// performed when sizing them is wasted work.
+
+static void ParallelFillValueInit(int numElements)
+{
+    PROFILE_FUNCTION();
+    Vector<int> array(numElements);
+    tbb::parallel_for(tbb::blocked_range<int>(0, array.size()),
+                      [&](const tbb::blocked_range<int>& range) {
+                          for (size_t i = range.begin(); i < range.end(); ++i) {
+                              array[i] = Computation(1, 1, i);
+                          }
+                      });
+    ASSERT(array.back() == Computation(1, 1, numElements - 1));
+}
+
+static void ParallelFillDefaultInit(int numElements)
+{
+    PROFILE_FUNCTION();
+    Vector<int> array(numElements, DefaultInit);
+    tbb::parallel_for(tbb::blocked_range<int>(0, array.size()),
+                      [&](const tbb::blocked_range<int>& range) {
+                          for (size_t i = range.begin(); i < range.end(); ++i) {
+                              array[i] = Computation(1, 1, i);
+                          }
+                      });
+    ASSERT(array.back() == Computation(1, 1, numElements - 1));
+}
+
 int main(int argc, char** argv)
 {
     // Parse arguments.
@@ -38,6 +69,10 @@ int main(int argc, char** argv)
     }
 
     int numElements = DeserializeValue<int>(argv[1]);
+    if (numElements <= 0) {
+        printf("NUM_ELEMENTS must be positive.\n");
+        return EXIT_FAILURE;
+    }
 
     // Run serial computation.
     std::vector<int> arrayA(numElements, 1);
@@ -47,5 +82,11 @@ int main(int argc, char** argv)
     std::vector<int> arrayB(numElements, 1);
     ParallelFor(arrayB);
 
+    // Zero-fill the output buffer before computing into it.
+    ParallelFillValueInit(numElements);
+
+    // Only reserve and size the output buffer before computing into it.
+    ParallelFillDefaultInit(numElements);
+
     return EXIT_SUCCESS;
 }
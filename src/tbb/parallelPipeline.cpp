@@ -1,16 +1,30 @@
-#include <tbb/pipeline.h>
+#include <tbb/info.h>
+#include <tbb/parallel_pipeline.h>
 
+#include <objectPool.h>
+
+#include <algorithm>
 #include <stdio.h>
+#include <span>
 #include <vector>
-#include <array>
 
 #include "utils.h"
 
-// Slice of an array.
-constexpr int SLICE_SIZE = 100;
-using Slice = std::array<int, SLICE_SIZE>;
+// Slice of an array, copied out of it.
+using Slice = std::vector<int>;
+
+// View of a slice of an array.
+using SliceView = std::span<const int>;
+
+// Number of elements in each slice, unless given on the command line.
+constexpr int DEFAULT_SLICE_SIZE = 100;
 
-static int ProcessSlice(const Slice& slice)
+// Slices in flight through the parallel pipelines at once, for each thread:
+// enough to keep every thread busy while the serial filters catch up,
+// without a token, and a slice, for every chunk of the array.
+constexpr size_t TOKENS_PER_THREAD = 4;
+
+static int ProcessSlice(SliceView slice)
 {
     int sum = 0;
     for (size_t index = 0; index < slice.size(); ++index) {
@@ -19,43 +33,60 @@ static int ProcessSlice(const Slice& slice)
     return sum;
 }
 
-static std::vector<int> SerialPipeline(std::vector<int>& array)
+static size_t ComputeNumTokens(size_t arraySize, size_t sliceSize)
+{
+    size_t numSlices = (arraySize + sliceSize - 1) / sliceSize;
+    size_t numThreads = tbb::info::default_concurrency();
+    return std::max<size_t>(
+        std::min(numSlices, TOKENS_PER_THREAD * numThreads), 1);
+}
+
+static std::vector<int> SerialPipeline(std::vector<int>& array,
+                                       size_t sliceSize)
 {
     PROFILE_FUNCTION();
 
+    // A single slice is reused for every chunk, as only one is in flight.
+    Slice slice(sliceSize);
+
     std::vector<int> outputArray;
-    for (size_t index = 0; index < array.size(); index += SLICE_SIZE) {
+    for (size_t index = 0; index < array.size(); index += sliceSize) {
         // Data input.
         int begin = index;
-        int end = index + SLICE_SIZE;
-        if (index + SLICE_SIZE > array.size()) {
+        int end = index + sliceSize;
+        if (index + sliceSize > array.size()) {
             end = array.size();
+            std::fill(slice.begin() + (end - begin), slice.end(), 0);
         }
-        Slice* slice = new Slice();
-        slice->fill(0);
-        std::copy(array.begin() + begin, array.begin() + end, slice->begin());
+        std::copy(array.begin() + begin, array.begin() + end, slice.begin());
 
         // Data transformation.
-        int result = ProcessSlice(*slice);
+        int result = ProcessSlice(slice);
 
         // Data output
         outputArray.push_back(result);
-
-        // Clean up.
-        delete slice;
     }
 
     return outputArray;
 }
 
-static std::vector<int> ParallelPipeline(std::vector<int>& array)
+static std::vector<int> ParallelPipeline(std::vector<int>& array,
+                                         size_t sliceSize)
 {
     PROFILE_FUNCTION();
 
+    // Each token carries a slice, so a pool of one slice per token recycles
+    // them between the filters, rather than allocating one per chunk.  The
+    // pipeline must run with the same numTokens, and the process filter
+    // release each slice before its token retires, so that a slice is
+    // always free for the input filter.
+    size_t numTokens = ComputeNumTokens(array.size(), sliceSize);
+    ObjectPool<Slice> slicePool(numTokens, Slice(sliceSize));
+
     // Serial input filter.
-    int index = 0;
-    tbb::filter_t<void, Slice*> inputFilter(
-        tbb::filter::serial_in_order,
+    size_t index = 0;
+    tbb::filter<void, Slice*> inputFilter(
+        tbb::filter_mode::serial_in_order,
         [&](tbb::flow_control& flowControl) -> Slice* {
             if (index >= array.size()) {
                 flowControl.stop();
@@ -64,40 +95,87 @@ static std::vector<int> ParallelPipeline(std::vector<int>& array)
 
             // Data input.
             int begin = index;
-            int end = index + SLICE_SIZE;
-            if (index + SLICE_SIZE > array.size()) {
+            int end = index + sliceSize;
+            Slice* slice = slicePool.try_acquire();
+            ASSERT(slice != nullptr);
+            if (index + sliceSize > array.size()) {
+                // Only a short final chunk leaves a stale tail to clear.
                 end = array.size();
+                std::fill(slice->begin() + (end - begin), slice->end(), 0);
             }
-            Slice* slice = new Slice();
-            slice->fill(0);
             std::copy(
                 array.begin() + begin, array.begin() + end, slice->begin());
 
-            index += SLICE_SIZE;
+            index += sliceSize;
 
             return slice;
         });
 
     // Parallel processing filter.
-    tbb::filter_t<Slice*, int> processFilter(
-        tbb::filter::parallel, [=](Slice* slice) {
+    tbb::filter<Slice*, int> processFilter(
+        tbb::filter_mode::parallel, [&](Slice* slice) {
             int result = ProcessSlice(*slice);
-            delete slice;
+            slicePool.release(slice);
             return result;
         });
 
     // Serial output filter.
     std::vector<int> outputArray;
-    tbb::filter_t<int, void> outputFilter(
-        tbb::filter::serial_in_order,
+    tbb::filter<int, void> outputFilter(
+        tbb::filter_mode::serial_in_order,
         [&](int result) { outputArray.push_back(result); });
 
-    tbb::filter_t<void, void> filters =
+    tbb::filter<void, void> filters =
         inputFilter & processFilter & outputFilter;
 
     // Configure level of parallelism, then execute pipeline.
-    size_t parallelLevel = (array.size() + SLICE_SIZE - 1) / SLICE_SIZE;
-    tbb::parallel_pipeline(parallelLevel, filters);
+    tbb::parallel_pipeline(numTokens, filters);
+
+    return outputArray;
+}
+
+static std::vector<int> ParallelPipelineViews(const std::vector<int>& array,
+                                              size_t sliceSize)
+{
+    PROFILE_FUNCTION();
+
+    // Serial input filter, which passes views into the array rather than
+    // copying each slice out of it.
+    size_t index = 0;
+    tbb::filter<void, SliceView> inputFilter(
+        tbb::filter_mode::serial_in_order,
+        [&](tbb::flow_control& flowControl) -> SliceView {
+            if (index >= array.size()) {
+                flowControl.stop();
+                return SliceView();
+            }
+
+            // Data input.
+            size_t count = std::min(sliceSize, array.size() - index);
+            SliceView slice(array.data() + index, count);
+
+            index += sliceSize;
+
+            return slice;
+        });
+
+    // Parallel processing filter.
+    tbb::filter<SliceView, int> processFilter(
+        tbb::filter_mode::parallel,
+        [](SliceView slice) { return ProcessSlice(slice); });
+
+    // Serial output filter.
+    std::vector<int> outputArray;
+    tbb::filter<int, void> outputFilter(
+        tbb::filter_mode::serial_in_order,
+        [&](int result) { outputArray.push_back(result); });
+
+    tbb::filter<void, void> filters =
+        inputFilter & processFilter & outputFilter;
+
+    // Configure level of parallelism, then execute pipeline.
+    size_t numTokens = ComputeNumTokens(array.size(), sliceSize);
+    tbb::parallel_pipeline(numTokens, filters);
 
     return outputArray;
 }
@@ -105,31 +183,39 @@ static std::vector<int> ParallelPipeline(std::vector<int>& array)
 int main(int argc, char** argv)
 {
     // Parse arguments.
-    if (argc != 2) {
-        printf("usage: tbb_parallelPipeline <NUM_ELEMENTS>\n");
+    if (argc != 2 && argc != 3) {
+        printf("usage: tbb_parallelPipeline <NUM_ELEMENTS> [SLICE_SIZE]\n");
         return EXIT_FAILURE;
     }
 
     int numElements = DeserializeValue<int>(argv[1]);
+    int sliceSize =
+        argc == 3 ? DeserializeValue<int>(argv[2]) : DEFAULT_SLICE_SIZE;
+    ASSERT(sliceSize > 0);
 
     // Run serial pipeline.
     std::vector<int> arrayA(numElements);
     for (size_t i = 0; i < arrayA.size(); ++i) {
         arrayA[i] = i;
     }
-    std::vector<int> outputA = SerialPipeline(arrayA);
+    std::vector<int> outputA = SerialPipeline(arrayA, sliceSize);
 
     // Run parallel pipeline.
     std::vector<int> arrayB(numElements);
     for (size_t i = 0; i < arrayB.size(); ++i) {
         arrayB[i] = i;
     }
-    std::vector<int> outputB = ParallelPipeline(arrayB);
+    std::vector<int> outputB = ParallelPipeline(arrayB, sliceSize);
+
+    // Run parallel pipeline over views of the same array.
+    std::vector<int> outputC = ParallelPipelineViews(arrayB, sliceSize);
 
     // Compare results.
     ASSERT(outputA.size() == outputB.size());
+    ASSERT(outputA.size() == outputC.size());
     for (size_t index = 0; index < outputA.size(); ++index) {
         ASSERT(outputA[index] == outputB[index]);
+        ASSERT(outputA[index] == outputC[index]);
     }
 
     return EXIT_SUCCESS;